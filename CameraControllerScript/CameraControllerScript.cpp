@@ -30,9 +30,9 @@ CameraControllerScript::CameraControllerScript(Entity const& entity)
 // ----------------------------------------- System's virtual functions -- == //
 void CameraControllerScript::setup() {
     // Set event listeners
-    registry.listen<OnCollisionEnter>(
+    listen<OnCollisionEnter>(
         MethodListener(CameraControllerScript::onCollisionEnter));
-    registry.listen<OnGameStateChange>(
+    listen<OnGameStateChange>(
         MethodListener(CameraControllerScript::onGameStateChange));
 
     // Set utility functors
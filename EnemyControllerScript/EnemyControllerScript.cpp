@@ -64,18 +64,22 @@ EnemyControllerScript::EnemyControllerScript(Entity const& entity)
 
 // ----------------------------------------- System's virtual functions -- == //
 void EnemyControllerScript::setup() {
-    registry.listen<OnCollisionEnter>(
+    listen<OnCollisionEnter>(
         MethodListener(EnemyControllerScript::onCollisionEnter));
-    registry.listen<OnGameStateChange>(
+    listen<OnCollisionStay>(
+        MethodListener(EnemyControllerScript::onCollisionStay));
+    listen<OnGameStateChange>(
         MethodListener(EnemyControllerScript::onGameStateChange));
-    // registry.listen<OnTriggerEnter>(
+    // listen<OnTriggerEnter>(
     //    MethodListener(EnemyControllerScript::onTriggerEnter));
     isKeyPressed = [](int const key) {
         return registry.system<RenderSystem>()->window->keyboard.KeyIsPressed(
             key);
     };
-    playerId =
-        registry.system<PropertySystem>()->findEntityByTag("Player").at(0).id;
+    playerId = registry.system<PropertySystem>()
+                   ->findEntityByTag("Player")
+                   .at(0)
+                   .handle();
 
     entity.add<CheckCollisions>({});
 };
@@ -119,33 +123,36 @@ void EnemyControllerScript::update(float const deltaTime) {
 };
 
 // ------------------------------------------------------------- Events -- == //
-void EnemyControllerScript::onCollisionEnter(OnCollisionEnter const& event) {
-    if (event.a.id == entity.id || event.b.id == entity.id) {
-        auto other = Entity(event.a.id == entity.id ? event.b.id : event.a.id);
+void EnemyControllerScript::onCollisionEnter(
+    std::span<OnCollisionEnter const> const events) {
+    for (auto const& event : events) {
+        if (event.a.id == entity.id || event.b.id == entity.id) {
+            handleCollision(event.a, event.b);
+        }
+    }
+}
+
+// Boundaries touched while the last bounce cools down are checked again in
+// every frame the contact lasts
+void EnemyControllerScript::onCollisionStay(
+    std::span<OnCollisionStay const> const events) {
+    for (auto const& event : events) {
+        if (event.a.id == entity.id || event.b.id == entity.id) {
+            handleCollision(event.a, event.b);
+        }
     }
+}
 
+void EnemyControllerScript::handleCollision(Entity const& a, Entity const& b) {
     // This should be inside onTriggerEnter handler, but maybe will work here,
     // too
-    if (event.a.id == entity.id || event.b.id == entity.id) {
-        auto other = Entity(event.a.id == entity.id ? event.b.id : event.a.id);
-        auto otherTag = other.get<Properties>().tag;
-
-        if (otherTag == "Boundary" && timeToBounce >= 0.3f) {
-            movingLeft = !movingLeft;
-            timeToBounce = 0.0f;
-
-            auto& boxCollider = entity.get<BoxCollider>();
-            boxCollider.separatingVectorSum += event.minSeparatingVector;
-            if (std::abs(event.minSeparatingVector.x) > 0.0f) {
-                boxCollider.numberOfCollisions.x++;
-            }
-            if (std::abs(event.minSeparatingVector.y) > 0.0f) {
-                boxCollider.numberOfCollisions.y++;
-            }
-            if (std::abs(event.minSeparatingVector.z) > 0.0f) {
-                boxCollider.numberOfCollisions.z++;
-            }
-        }
+    auto other = Entity(a.id == entity.id ? b.id : a.id);
+    auto otherTag = other.get<Properties>().tag;
+
+    if (otherTag == "Boundary" && timeToBounce >= 0.3f) {
+        movingLeft = !movingLeft;
+        timeToBounce = 0.0f;
+        registry.system<ColliderSystem>()->Separate(entity, other);
     }
 }
 void EnemyControllerScript::onGameStateChange(OnGameStateChange const& event) {
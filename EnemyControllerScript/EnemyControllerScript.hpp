@@ -2,10 +2,12 @@
 
 // ///////////////////////////////////////////////////////////////// Includes //
 #include <memory>
+#include <span>
 
 #include "ECS/Entity.hpp"
 #include "EnemyControllerScriptAPI.hpp"
 #include "Events/OnCollisionEnter.hpp"
+#include "Events/OnCollisionStay.hpp"
 #include "Events/OnGameStateChange.hpp"
 #include "Script.hpp"
 
@@ -22,7 +24,9 @@ class ENEMYCONTROLLERSCRIPT_API EnemyControllerScript : public Script {
     void update(float const deltaTime) override;
 
     // --------------------------------------------------------- Events -- == //
-    void onCollisionEnter(OnCollisionEnter const &event);
+    void onCollisionEnter(std::span<OnCollisionEnter const> events);
+    void onCollisionStay(std::span<OnCollisionStay const> events);
+    void handleCollision(Entity const &a, Entity const &b);
     void onGameStateChange(OnGameStateChange const &event);
     // void onTriggerEnter(OnTriggerEnter const &event);
 
@@ -49,7 +53,7 @@ class ENEMYCONTROLLERSCRIPT_API EnemyControllerScript : public Script {
     bool movingLeft = true;
     // for Rook
     bool movingSideways = true;
-    EntityId playerId;
+    EntityHandle playerId;
     float playerDistance = 10.0f;
     float timeToBounce = 0.0f;
     float rookTimer = 0.0f;
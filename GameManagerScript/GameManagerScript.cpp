@@ -5,8 +5,8 @@
 #include "GameManagerScript.hpp"
 
 #include <filesystem>
+#include <future>
 #include <random>
-#include <thread>
 
 #include "Camera.h"
 #include "Components/Components.hpp"
@@ -36,7 +36,24 @@ void interpolateTextTo(EntityId entity, float const target,
 }
 
 // //////////////////////////////////////////////////////////////// Variables //
-std::unique_ptr<std::thread> cacheThread;
+// Caching reads the prefab of the next chunk from the disk, on a thread of
+// its own instead of the job system, so waiting for the jobs of a frame
+// never ends up blocked on the file
+std::future<void> chunkCaching;
+
+// //////////////////////////////////////////////////////////// Chunk caching //
+void finishChunkCaching() {
+    if (chunkCaching.valid()) {
+        chunkCaching.get();
+    }
+}
+
+void cacheChunk(std::string const& path) {
+    finishChunkCaching();
+    chunkCaching = std::async(std::launch::async, [path] {
+        Registry::instance().system<SceneSystem>()->cachePrefab(path);
+    });
+}
 
 // ///////////////////////////////////////////////////////// Factory function //
 extern "C" GAMEMANAGERSCRIPT_API void create(std::shared_ptr<Script>& script,
@@ -51,13 +68,13 @@ GameManagerScript::GameManagerScript(Entity const& entity) : Script(entity){};
 // ----------------------------------------- System's virtual functions -- == //
 void GameManagerScript::setup() {
     // Set event listeners
-    registry.listen<OnCollisionEnter>(
+    listen<OnCollisionEnter>(
         MethodListener(GameManagerScript::onCollisionEnter));
-    registry.listen<OnGameStateChange>(
+    listen<OnGameStateChange>(
         MethodListener(GameManagerScript::onGameStateChange));
-    registry.listen<OnButtonClick>(
+    listen<OnButtonClick>(
         MethodListener(GameManagerScript::onButtonClick));
-    registry.listen<OnButtonHover>(
+    listen<OnButtonHover>(
         MethodListener(GameManagerScript::onButtonHover));
 
     // Set helpers
@@ -112,8 +129,10 @@ void GameManagerScript::setup() {
 
     spawnTorches();
 
-    playerId =
-        registry.system<PropertySystem>()->findEntityByTag("Player").at(0).id;
+    playerId = registry.system<PropertySystem>()
+                   ->findEntityByTag("Player")
+                   .at(0)
+                   .handle();
 
     cameraId = registry.system<PropertySystem>()
                    ->findEntityByTag("MainCamera")
@@ -211,8 +230,10 @@ void GameManagerScript::setup() {
         pauseMenuGroup.push_back(pauseMenuExitButton);
     }
 
-    menuChunk =
-        registry.system<PropertySystem>()->findEntityByName("Menu").at(0).id;
+    menuChunk = registry.system<PropertySystem>()
+                    ->findEntityByName("Menu")
+                    .at(0)
+                    .handle();
     menuOriginalOffset = Entity(menuChunk).get<Transform>().position -
                          Entity(playerId).get<Transform>().position;
     menuCamera = registry.system<PropertySystem>()
@@ -344,12 +365,9 @@ void GameManagerScript::update(float const deltaTime) {
                               ->spawnPrefab(CHUNKS_DIRECTORY + "\\Chunk "
                                                                "Start.prefab",
                                             false)
-                              .id,
+                              .handle(),
                 .endPositionInParts = generatedLengthInParts});
-            cacheThread = std::make_unique<std::thread>([this] {
-                Registry::instance().system<SceneSystem>()->cachePrefab(
-                    CHUNKS_DIRECTORY + "\\chunk-tmw-a-1-cc-01.prefab");
-            });
+            cacheChunk(CHUNKS_DIRECTORY + "\\chunk-tmw-a-1-cc-01.prefab");
             nextChunk = "chunk-tmw-a-1-cc-01";
 
             updateWaterfallRefraction();
@@ -358,7 +376,7 @@ void GameManagerScript::update(float const deltaTime) {
             spawnBishops(spawnChance);
             spawnRooks(spawnChance, false);
 
-            registry.system<GraphSystem>()->setup();
+            registry.system<GraphSystem>()->refresh();
 
             registry.send(OnGameStateChange{.nextState = GAME_LAUNCH_FADE_IN});
         } break;
@@ -487,7 +505,6 @@ void GameManagerScript::update(float const deltaTime) {
                     i->entity);
                 presentChunks.erase(i);
             } while (!presentChunks.empty());
-            registry.system<GraphSystem>()->setup();
 
             presentChunks.push_back(Chunk{
                 .name = "Chunk Start",
@@ -495,15 +512,9 @@ void GameManagerScript::update(float const deltaTime) {
                               ->spawnPrefab(CHUNKS_DIRECTORY + "\\Chunk "
                                                                "Start.prefab",
                                             false)
-                              .id,
+                              .handle(),
                 .endPositionInParts = generatedLengthInParts});
-            if (cacheThread) {
-                cacheThread->join();
-            }
-            cacheThread = std::make_unique<std::thread>([this] {
-                Registry::instance().system<SceneSystem>()->cachePrefab(
-                    CHUNKS_DIRECTORY + "\\chunk-tmw-a-1-cc-01.prefab");
-            });
+            cacheChunk(CHUNKS_DIRECTORY + "\\chunk-tmw-a-1-cc-01.prefab");
             nextChunk = "chunk-tmw-a-1-cc-01";
 
             updateWaterfallRefraction();
@@ -512,7 +523,7 @@ void GameManagerScript::update(float const deltaTime) {
             spawnBishops(spawnChance);
             spawnRooks(spawnChance, false);
 
-            registry.system<GraphSystem>()->setup();
+            registry.system<GraphSystem>()->refresh();
 
             registry.send(OnGameStateChange{.nextState = GAME_FADE_IN});
         } break;
@@ -525,8 +536,9 @@ void GameManagerScript::update(float const deltaTime) {
 
 // ------------------------------------------------------------- Events -- == //
 void GameManagerScript::onCollisionEnter(OnCollisionEnter const& event) {
-    if (event.a.id == playerId || event.b.id == playerId) {
-        auto other = Entity(event.a.id == playerId ? event.b.id : event.a.id);
+    if (event.a.id == playerId.id() || event.b.id == playerId.id()) {
+        auto other =
+            Entity(event.a.id == playerId.id() ? event.b.id : event.a.id);
         auto otherTag = other.get<Properties>().tag;
 
         if (otherTag == "Torch") {
@@ -658,8 +670,13 @@ void GameManagerScript::spawnBishops(int percentage) {
     }
 }
 
-void GameManagerScript::spawnEnemy(MovementType mt, EntityId spawnPoint,
+void GameManagerScript::spawnEnemy(MovementType mt, EntityHandle spawnPoint,
                                    int percentage, bool movingSideways) {
+    // The spawn point could've been destroyed together with its chunk
+    if (!registry.valid(spawnPoint)) {
+        return;
+    }
+
     if (shouldHappen(percentage)) {
         std::shared_ptr<Entity> enemy;
         if (mt == Bishop) {
@@ -715,7 +732,7 @@ void GameManagerScript::findSpawnPoints(MovementType mt) {
     spawnPoints.clear();
     for (auto it : registry.system<PropertySystem>()->findEntityByTag(
              "EnemySpawnPoint" + enumToString(mt))) {
-        spawnPoints.push_back(it.id);
+        spawnPoints.push_back(it.handle());
     }
 }
 
@@ -792,7 +809,7 @@ void GameManagerScript::handleChunkSpawning(float deltaTime) {
         ++spawnedChunks;
 
         // Potentially wait for this chunk caching to finish
-        cacheThread->join();
+        finishChunkCaching();
 
         // Update the length of all spawned chunks so far
         generatedLengthInParts += lengthOfChunk.at(nextChunk);
@@ -804,7 +821,7 @@ void GameManagerScript::handleChunkSpawning(float deltaTime) {
             CHUNKS_DIRECTORY + "\\" + nextChunk + ".prefab", false);
         presentChunks.push_back(
             Chunk{.name = nextChunk,
-                  .entity = chunk.id,
+                  .entity = chunk.handle(),
                   .endPositionInParts = generatedLengthInParts});
 
         spawnDuration = chunkSpawnTime.Peek();
@@ -838,9 +855,10 @@ void GameManagerScript::handleChunkSpawning(float deltaTime) {
         for (auto const& chunk : presentChunks) {
             if (chunk.endPositionInParts * PART_LENGTH_IN_WORLD_UNITS <=
                 playerPositionInWorldUnits - SPAWN_PADDING_IN_WORLD_UNITS) {
+                assert(registry.valid(chunk.entity) &&
+                       "Chunk must still exist when it's being deleted!");
                 registry.system<GraphSystem>()->destroyEntityWithChildren(
                     chunk.entity);
-                registry.system<GraphSystem>()->setup();
                 presentChunks.erase(i);
                 break;
             }
@@ -859,16 +877,13 @@ void GameManagerScript::handleChunkSpawning(float deltaTime) {
             nextChunk = potentialChunks.at(distribution(generator));
         } while (nextChunk == "Chunk Start");
 
-        cacheThread = std::make_unique<std::thread>([this] {
-            registry.system<SceneSystem>()->cachePrefab(
-                CHUNKS_DIRECTORY + "\\" + nextChunk + ".prefab");
-        });
+        cacheChunk(CHUNKS_DIRECTORY + "\\" + nextChunk + ".prefab");
 
         // Update the spawned objects if needed
         updateWaterfallRefraction();
         updateTrapRefraction();
 
-        registry.system<GraphSystem>()->setup();
+        registry.system<GraphSystem>()->refresh();
     }
     if (shake) {
         shakeCamera(deltaTime);
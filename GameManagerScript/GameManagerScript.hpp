@@ -55,7 +55,8 @@ class GAMEMANAGERSCRIPT_API GameManagerScript : public Script {
 
     float resultsTimer = 0.0f;
 
-    EntityId menuChunk, menuCamera;
+    EntityHandle menuChunk;
+    EntityId menuCamera;
     DirectX::XMFLOAT3 menuOriginalOffset, menuCameraOriginalOffset;
 
     // UI
@@ -72,15 +73,15 @@ class GAMEMANAGERSCRIPT_API GameManagerScript : public Script {
     void spawnTorches();
     void spawnRooks(int percentage, bool movingSideways = true);
     void spawnBishops(int percentage);
-    void spawnEnemy(MovementType mt, EntityId spawnPoint, int percentage,
+    void spawnEnemy(MovementType mt, EntityHandle spawnPoint, int percentage,
                     bool movingSideways = true);
     bool shouldHappen(int percentage);
     void findSpawnPoints(MovementType mt);
     void shakeCamera(float deltaTime);
     std::string enumToString(MovementType mt);
 
-    EntityId playerId;
-    std::vector<EntityId> spawnPoints;
+    EntityHandle playerId;
+    std::vector<EntityHandle> spawnPoints;
     std::shared_ptr<CameraControllerScript> cameraScript;
     EntityId cameraId;
     bool shake = false;
@@ -100,7 +101,7 @@ class GAMEMANAGERSCRIPT_API GameManagerScript : public Script {
 
     struct Chunk {
         ChunkName name;
-        EntityId entity;
+        EntityHandle entity;
         int endPositionInParts;
     };
 
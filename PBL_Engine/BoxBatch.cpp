@@ -0,0 +1,120 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "BoxBatch.hpp"
+
+#include <emmintrin.h>
+
+#include <cassert>
+
+#include "FrustumCulling.h"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+void BoxBatch::clear() {
+    for (auto* coordinates : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+        coordinates->clear();
+    }
+    entityIds.clear();
+}
+
+void BoxBatch::add(DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max,
+                   EntityId const entityId) {
+    auto const index = entityIds.size();
+    if (index % LANES == 0) {
+        for (auto* coordinates : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+            coordinates->resize(index + LANES, 0.0f);
+        }
+    }
+
+    minX[index] = min.x;
+    minY[index] = min.y;
+    minZ[index] = min.z;
+    maxX[index] = max.x;
+    maxY[index] = max.y;
+    maxZ[index] = max.z;
+    entityIds.push_back(entityId);
+}
+
+std::vector<std::uint8_t> const& BoxBatch::overlapMasks(
+    DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max,
+    size_t const first, size_t const last) {
+    assert(first <= last && last <= size() && "Boxes out of the batch");
+
+    auto const otherMinX = _mm_set1_ps(min.x), otherMaxX = _mm_set1_ps(max.x);
+    auto const otherMinY = _mm_set1_ps(min.y), otherMaxY = _mm_set1_ps(max.y);
+    auto const otherMinZ = _mm_set1_ps(min.z), otherMaxZ = _mm_set1_ps(max.z);
+
+    auto const firstBlock = first / LANES;
+    masks.resize((last + LANES - 1) / LANES - firstBlock);
+    for (size_t block = 0; block < masks.size(); ++block) {
+        auto const i = (firstBlock + block) * LANES;
+        auto overlapping =
+            _mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(&maxX[i]), otherMinX),
+                       _mm_cmplt_ps(_mm_loadu_ps(&minX[i]), otherMaxX));
+        overlapping = _mm_and_ps(
+            overlapping,
+            _mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(&maxY[i]), otherMinY),
+                       _mm_cmplt_ps(_mm_loadu_ps(&minY[i]), otherMaxY)));
+        overlapping = _mm_and_ps(
+            overlapping,
+            _mm_and_ps(_mm_cmpgt_ps(_mm_loadu_ps(&maxZ[i]), otherMinZ),
+                       _mm_cmplt_ps(_mm_loadu_ps(&minZ[i]), otherMaxZ)));
+        masks[block] = static_cast<std::uint8_t>(_mm_movemask_ps(overlapping));
+    }
+
+    // Drop the lanes of the first and last block outside of the range
+    if (!masks.empty()) {
+        masks.front() &= ~((1u << (first % LANES)) - 1u);
+        if (auto const used = last % LANES; used != 0) {
+            masks.back() &= (1u << used) - 1u;
+        }
+    }
+    return masks;
+}
+
+std::vector<std::uint8_t> const& BoxBatch::frustumMasks(
+    CFrustum const& frustum) {
+    __m128 normalsX[6], normalsY[6], normalsZ[6], distances[6];
+    for (size_t i = 0; i < 6; ++i) {
+        normalsX[i] = _mm_set1_ps(frustum.p[i].normal.x);
+        normalsY[i] = _mm_set1_ps(frustum.p[i].normal.y);
+        normalsZ[i] = _mm_set1_ps(frustum.p[i].normal.z);
+        distances[i] = _mm_set1_ps(frustum.p[i].d);
+    }
+
+    masks.resize(minX.size() / LANES);
+    for (size_t block = 0; block < masks.size(); ++block) {
+        auto const i = block * LANES;
+        auto const blockMinX = _mm_loadu_ps(&minX[i]);
+        auto const blockMinY = _mm_loadu_ps(&minY[i]);
+        auto const blockMinZ = _mm_loadu_ps(&minZ[i]);
+        auto const blockMaxX = _mm_loadu_ps(&maxX[i]);
+        auto const blockMaxY = _mm_loadu_ps(&maxY[i]);
+        auto const blockMaxZ = _mm_loadu_ps(&maxZ[i]);
+
+        // The corner farthest along the normal decides, its coordinates give
+        // the larger products
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (size_t j = 0; j < 6; ++j) {
+            auto distance = _mm_add_ps(
+                _mm_max_ps(_mm_mul_ps(normalsX[j], blockMinX),
+                           _mm_mul_ps(normalsX[j], blockMaxX)),
+                distances[j]);
+            distance = _mm_add_ps(
+                distance, _mm_max_ps(_mm_mul_ps(normalsY[j], blockMinY),
+                                     _mm_mul_ps(normalsY[j], blockMaxY)));
+            distance = _mm_add_ps(
+                distance, _mm_max_ps(_mm_mul_ps(normalsZ[j], blockMinZ),
+                                     _mm_mul_ps(normalsZ[j], blockMaxZ)));
+            inside = _mm_and_ps(inside,
+                                _mm_cmpgt_ps(distance, _mm_setzero_ps()));
+        }
+        masks[block] = static_cast<std::uint8_t>(_mm_movemask_ps(inside));
+    }
+
+    if (auto const used = entityIds.size() % LANES; used != 0) {
+        masks.back() &= (1u << used) - 1u;
+    }
+    return masks;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
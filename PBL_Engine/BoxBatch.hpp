@@ -0,0 +1,90 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "ECS/Utilities.hpp"
+#include "EngineAPI.hpp"
+
+// ///////////////////////////////////////////////////// Forward declarations //
+class CFrustum;
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Axis-aligned boxes stored as separate arrays of their coordinates, so one
+// box or frustum is tested against a whole block of them with SSE. The tests
+// give a mask per block with a bit set for every box that passes
+class ENGINE_API BoxBatch {
+  public:
+    // ============================================================== Data == //
+    static constexpr size_t LANES = 4u;
+
+    // ========================================================= Behaviour == //
+    void clear();
+    void add(DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max,
+             EntityId entityId);
+    size_t size() const { return entityIds.size(); }
+
+    // Overlap is strict, same as ColliderSystem::CheckBoxesCollision. Only
+    // the boxes from first up to last are tested, the masks start with the
+    // block holding the first one
+    std::vector<std::uint8_t> const& overlapMasks(DirectX::XMFLOAT3 const& min,
+                                                  DirectX::XMFLOAT3 const& max,
+                                                  size_t first, size_t last);
+    std::vector<std::uint8_t> const& overlapMasks(
+        DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max) {
+        return overlapMasks(min, max, 0u, size());
+    }
+    // Boxes at least partially in front of all the planes
+    std::vector<std::uint8_t> const& frustumMasks(CFrustum const& frustum);
+
+    // Visit the identifiers given to add together with the boxes' indices
+    template <typename Function>
+    void eachOverlapping(DirectX::XMFLOAT3 const& min,
+                         DirectX::XMFLOAT3 const& max, size_t const first,
+                         size_t const last, Function&& function) {
+        each(overlapMasks(min, max, first, last), first / LANES, function);
+    }
+
+    template <typename Function>
+    void eachOverlapping(DirectX::XMFLOAT3 const& min,
+                         DirectX::XMFLOAT3 const& max, Function&& function) {
+        eachOverlapping(min, max, 0u, size(), function);
+    }
+
+    template <typename Function>
+    void eachInFrustum(CFrustum const& frustum, Function&& function) {
+        each(frustumMasks(frustum), 0u, function);
+    }
+
+  private:
+    // ========================================================= Behaviour == //
+    template <typename Function>
+    void each(std::vector<std::uint8_t> const& masks, size_t const firstBlock,
+              Function& function) {
+        for (size_t block = 0; block < masks.size(); ++block) {
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                if (masks[block] & (1u << lane)) {
+                    auto const index = (firstBlock + block) * LANES + lane;
+                    if constexpr (std::is_invocable_v<Function&, EntityId,
+                                                      size_t>) {
+                        function(entityIds[index], index);
+                    } else {
+                        function(entityIds[index]);
+                    }
+                }
+            }
+        }
+    }
+
+    // ============================================================== Data == //
+    // Padded to whole blocks, the padding is masked out of the results
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    std::vector<EntityId> entityIds;
+    std::vector<std::uint8_t> masks;
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,516 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "BroadPhase.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+// ///////////////////////////////////////////////////////////////// Helpers //
+namespace {
+DirectX::XMFLOAT3 minimum(DirectX::XMFLOAT3 const& a,
+                          DirectX::XMFLOAT3 const& b) {
+    return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+}
+
+DirectX::XMFLOAT3 maximum(DirectX::XMFLOAT3 const& a,
+                          DirectX::XMFLOAT3 const& b) {
+    return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+}
+
+float surface(DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max) {
+    auto const x = max.x - min.x, y = max.y - min.y, z = max.z - min.z;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+bool contains(DirectX::XMFLOAT3 const& outerMin,
+              DirectX::XMFLOAT3 const& outerMax,
+              DirectX::XMFLOAT3 const& innerMin,
+              DirectX::XMFLOAT3 const& innerMax) {
+    return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y &&
+           outerMin.z <= innerMin.z && innerMax.x <= outerMax.x &&
+           innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+}
+}  // namespace
+
+// //////////////////////////////////////////////////////////// Layer matrix //
+void LayerMatrix::ignore(unsigned int const a, unsigned int const b) {
+    assert(a < LAYERS && b < LAYERS && "There are only 32 layers!");
+    masks[a] &= ~(1u << b);
+    masks[b] &= ~(1u << a);
+}
+
+// //////////////////////////////////////////////////////////////// Interface //
+void BroadPhase::overlapBox(std::vector<Proxy> const& proxies,
+                            DirectX::XMFLOAT3 const& min,
+                            DirectX::XMFLOAT3 const& max,
+                            std::function<void(EntityId)> const& visit) {
+    for (auto const& proxy : proxies) {
+        if (overlap(proxy.min, proxy.max, min, max)) {
+            visit(proxy.entityId);
+        }
+    }
+}
+
+std::optional<BroadPhase::Hit> BroadPhase::raycast(
+    std::vector<Proxy> const& proxies, DirectX::XMFLOAT3 const& origin,
+    DirectX::XMFLOAT3 const& direction, float const maxDistance) {
+    std::optional<Hit> hit;
+    for (auto const& proxy : proxies) {
+        if (auto const distance =
+                intersect(origin, direction, hit ? hit->distance : maxDistance,
+                          proxy.min, proxy.max)) {
+            hit = Hit{.entityId = proxy.entityId, .distance = *distance};
+        }
+    }
+    return hit;
+}
+
+std::optional<float> BroadPhase::intersect(DirectX::XMFLOAT3 const& origin,
+                                           DirectX::XMFLOAT3 const& direction,
+                                           float const maxDistance,
+                                           DirectX::XMFLOAT3 const& min,
+                                           DirectX::XMFLOAT3 const& max) {
+    float const origins[] = {origin.x, origin.y, origin.z};
+    float const directions[] = {direction.x, direction.y, direction.z};
+    float const mins[] = {min.x, min.y, min.z};
+    float const maxes[] = {max.x, max.y, max.z};
+
+    // Clip the ray with the slabs between the faces on every axis
+    auto near = 0.0f, far = maxDistance;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (std::abs(directions[axis]) < 1e-8f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxes[axis]) {
+                return std::nullopt;
+            }
+            continue;
+        }
+
+        auto first = (mins[axis] - origins[axis]) / directions[axis];
+        auto second = (maxes[axis] - origins[axis]) / directions[axis];
+        if (first > second) {
+            std::swap(first, second);
+        }
+        near = std::max(near, first);
+        far = std::min(far, second);
+        if (near > far) {
+            return std::nullopt;
+        }
+    }
+    return near;
+}
+
+// ////////////////////////////////////////////////////////// Sweep and prune //
+void SweepAndPrune::findPairs(std::vector<Proxy> const& proxies,
+                              std::vector<Pair>& pairs) {
+    if (order.size() != proxies.size()) {
+        order.resize(proxies.size());
+        std::iota(order.begin(), order.end(), 0u);
+    }
+
+    // Insertion sort is close to linear for the order of the last frame
+    for (size_t i = 1; i < order.size(); ++i) {
+        auto const index = order[i];
+        auto j = i;
+        for (; j > 0 && proxies[order[j - 1]].min.x > proxies[index].min.x;
+             --j) {
+            order[j] = order[j - 1];
+        }
+        order[j] = index;
+    }
+
+    // Every box is checked against the earlier ones still open on the axis
+    open.clear();
+    for (auto const index : order) {
+        auto const& proxy = proxies[index];
+        std::erase_if(open, [&](size_t const other) {
+            return proxies[other].max.x <= proxy.min.x;
+        });
+        for (auto const other : open) {
+            if (overlap(proxies[other], proxy)) {
+                report(proxies[other], proxy, pairs);
+            }
+        }
+        open.push_back(index);
+    }
+}
+
+// ///////////////////////////////////////////////////////////// Spatial hash //
+void SpatialHash::findPairs(std::vector<Proxy> const& proxies,
+                            std::vector<Pair>& pairs) {
+    // Cells left empty since the last frame are dropped, the others keep
+    // their memory
+    std::erase_if(cells, [](auto const& cell) { return cell.second.empty(); });
+    for (auto& [key, indices] : cells) {
+        indices.clear();
+    }
+    large.clear();
+
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        auto const first = cell(proxies[i].min), last = cell(proxies[i].max);
+        auto const count = static_cast<size_t>(last.x - first.x + 1) *
+                           static_cast<size_t>(last.y - first.y + 1) *
+                           static_cast<size_t>(last.z - first.z + 1);
+        if (count > maxCellsPerBox) {
+            large.push_back(i);
+            continue;
+        }
+
+        for (auto x = first.x; x <= last.x; ++x) {
+            for (auto y = first.y; y <= last.y; ++y) {
+                for (auto z = first.z; z <= last.z; ++z) {
+                    cells[{x, y, z}].push_back(i);
+                }
+            }
+        }
+    }
+
+    // Boxes sharing several cells are reported only by the cell holding the
+    // lowest corner of their overlap
+    for (auto const& [key, indices] : cells) {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            for (size_t j = i + 1; j < indices.size(); ++j) {
+                auto const& a = proxies[indices[i]];
+                auto const& b = proxies[indices[j]];
+                if (!collide(a, b) || !overlap(a, b)) {
+                    continue;
+                }
+                auto const corner = cell({std::max(a.min.x, b.min.x),
+                                          std::max(a.min.y, b.min.y),
+                                          std::max(a.min.z, b.min.z)});
+                if (corner == key) {
+                    report(a, b, pairs);
+                }
+            }
+        }
+    }
+
+    if (large.empty()) {
+        return;
+    }
+    all.clear();
+    for (auto const& proxy : proxies) {
+        all.add(proxy.min, proxy.max, proxy.entityId);
+    }
+    for (auto const index : large) {
+        auto const& a = proxies[index];
+        all.eachOverlapping(a.min, a.max, [&](EntityId, size_t const j) {
+            if (j > index ||
+                !std::binary_search(large.begin(), large.end(), j)) {
+                report(a, proxies[j], pairs);
+            }
+        });
+    }
+}
+
+SpatialHash::Cell SpatialHash::cell(DirectX::XMFLOAT3 const& point) const {
+    return {static_cast<int>(std::floor(point.x / cellSize)),
+            static_cast<int>(std::floor(point.y / cellSize)),
+            static_cast<int>(std::floor(point.z / cellSize))};
+}
+
+// ///////////////////////////////////////////////////////////// Dynamic tree //
+// ============================================================= Behaviour == //
+void DynamicTree::findPairs(std::vector<Proxy> const& proxies,
+                            std::vector<Pair>& pairs) {
+    ++frame;
+
+    // Colliders which left their enlarged boxes are reinserted
+    for (auto const& proxy : proxies) {
+        auto [entry, inserted] =
+            entityToLeaf.try_emplace(proxy.entityId, NO_NODE);
+        if (inserted) {
+            entry->second = allocate();
+            nodes[entry->second].left = NO_NODE;
+            nodes[entry->second].right = NO_NODE;
+            nodes[entry->second].height = 0;
+        } else if (contains(nodes[entry->second].min, nodes[entry->second].max,
+                            proxy.min, proxy.max)) {
+            inserted = false;
+        } else {
+            remove(entry->second);
+            inserted = true;
+        }
+
+        auto& leaf = nodes[entry->second];
+        leaf.proxy = proxy;
+        leaf.frame = frame;
+        if (inserted) {
+            leaf.min = {proxy.min.x - margin, proxy.min.y - margin,
+                        proxy.min.z - margin};
+            leaf.max = {proxy.max.x + margin, proxy.max.y + margin,
+                        proxy.max.z + margin};
+            insert(entry->second);
+        }
+    }
+
+    // Leaves of the colliders which are gone
+    std::erase_if(entityToLeaf, [this](auto const& entry) {
+        if (nodes[entry.second].frame == frame) {
+            return false;
+        }
+        remove(entry.second);
+        release(entry.second);
+        return true;
+    });
+
+    // Pairs of two dynamic colliders are reported by the one with the
+    // smaller identifier
+    for (auto const& proxy : proxies) {
+        if (!proxy.dynamic) {
+            continue;
+        }
+        query(proxy.min, proxy.max, [&](NodeIndex const leaf) {
+            auto const& other = nodes[leaf].proxy;
+            if (other.entityId == proxy.entityId ||
+                (other.dynamic && other.entityId < proxy.entityId) ||
+                !overlap(proxy, other)) {
+                return;
+            }
+            report(proxy, other, pairs);
+        });
+    }
+}
+
+// The tree keeps its own copies of the proxies
+void DynamicTree::overlapBox(std::vector<Proxy> const&,
+                             DirectX::XMFLOAT3 const& min,
+                             DirectX::XMFLOAT3 const& max,
+                             std::function<void(EntityId)> const& visit) {
+    query(min, max, [&](NodeIndex const leaf) {
+        auto const& proxy = nodes[leaf].proxy;
+        if (overlap(proxy.min, proxy.max, min, max)) {
+            visit(proxy.entityId);
+        }
+    });
+}
+
+std::optional<BroadPhase::Hit> DynamicTree::raycast(
+    std::vector<Proxy> const&, DirectX::XMFLOAT3 const& origin,
+    DirectX::XMFLOAT3 const& direction, float const maxDistance) {
+    std::optional<Hit> hit;
+    std::vector<NodeIndex> pending;
+    if (root != NO_NODE) {
+        pending.push_back(root);
+    }
+
+    // Subtrees farther than the closest hit so far are skipped
+    while (!pending.empty()) {
+        auto const index = pending.back();
+        pending.pop_back();
+
+        auto const& node = nodes[index];
+        auto const distance = hit ? hit->distance : maxDistance;
+        if (!intersect(origin, direction, distance, node.min, node.max)) {
+            continue;
+        }
+        if (!node.leaf()) {
+            pending.push_back(node.left);
+            pending.push_back(node.right);
+        } else if (auto const leafDistance =
+                       intersect(origin, direction, distance, node.proxy.min,
+                                 node.proxy.max)) {
+            hit = Hit{.entityId = node.proxy.entityId,
+                      .distance = *leafDistance};
+        }
+    }
+    return hit;
+}
+
+// ------------------------------------------------------------ Helpers -- == //
+DynamicTree::NodeIndex DynamicTree::allocate() {
+    if (freeNodes == NO_NODE) {
+        nodes.emplace_back();
+        return static_cast<NodeIndex>(nodes.size() - 1);
+    }
+
+    auto const node = freeNodes;
+    freeNodes = nodes[node].parent;
+    return node;
+}
+
+void DynamicTree::release(NodeIndex const node) {
+    nodes[node].parent = freeNodes;
+    nodes[node].height = -1;
+    freeNodes = node;
+}
+
+void DynamicTree::insert(NodeIndex const leaf) {
+    if (root == NO_NODE) {
+        root = leaf;
+        nodes[leaf].parent = NO_NODE;
+        return;
+    }
+
+    // Go down towards the sibling whose box grows the least, including the
+    // growth of all the boxes on the way
+    auto const leafMin = nodes[leaf].min, leafMax = nodes[leaf].max;
+    auto sibling = root;
+    while (!nodes[sibling].leaf()) {
+        auto const& node = nodes[sibling];
+        auto const area = surface(node.min, node.max);
+        auto const combinedArea = surface(minimum(node.min, leafMin),
+                                          maximum(node.max, leafMax));
+        auto const cost = 2.0f * combinedArea;
+        auto const inheritedCost = 2.0f * (combinedArea - area);
+
+        auto const childCost = [&](NodeIndex const index) {
+            auto const& child = nodes[index];
+            auto const grown = surface(minimum(child.min, leafMin),
+                                       maximum(child.max, leafMax));
+            return inheritedCost +
+                   (child.leaf() ? grown
+                                 : grown - surface(child.min, child.max));
+        };
+        auto const leftCost = childCost(node.left);
+        auto const rightCost = childCost(node.right);
+
+        if (cost < leftCost && cost < rightCost) {
+            break;
+        }
+        sibling = leftCost < rightCost ? node.left : node.right;
+    }
+
+    // Join the leaf and its sibling under a new parent
+    auto const oldParent = nodes[sibling].parent;
+    auto const newParent = allocate();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NO_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+
+    refit(newParent);
+}
+
+void DynamicTree::remove(NodeIndex const leaf) {
+    if (leaf == root) {
+        root = NO_NODE;
+        return;
+    }
+
+    // The sibling takes the place of the parent
+    auto const parent = nodes[leaf].parent;
+    auto const grandparent = nodes[parent].parent;
+    auto const sibling = nodes[parent].left == leaf ? nodes[parent].right
+                                                    : nodes[parent].left;
+    nodes[sibling].parent = grandparent;
+    release(parent);
+
+    if (grandparent == NO_NODE) {
+        root = sibling;
+        return;
+    }
+    if (nodes[grandparent].left == parent) {
+        nodes[grandparent].left = sibling;
+    } else {
+        nodes[grandparent].right = sibling;
+    }
+    refit(grandparent);
+}
+
+void DynamicTree::refit(NodeIndex node) {
+    while (node != NO_NODE) {
+        node = balance(node);
+        fit(node);
+        node = nodes[node].parent;
+    }
+}
+
+DynamicTree::NodeIndex DynamicTree::balance(NodeIndex const node) {
+    if (nodes[node].leaf() || nodes[node].height < 2) {
+        return node;
+    }
+
+    auto const left = nodes[node].left, right = nodes[node].right;
+    auto const difference = nodes[right].height - nodes[left].height;
+    if (difference > 1) {
+        return rotate(node, right);
+    }
+    if (difference < -1) {
+        return rotate(node, left);
+    }
+    return node;
+}
+
+DynamicTree::NodeIndex DynamicTree::rotate(NodeIndex const node,
+                                           NodeIndex const child) {
+    // The taller child takes the place of the node
+    auto const parent = nodes[node].parent;
+    nodes[child].parent = parent;
+    if (parent == NO_NODE) {
+        root = child;
+    } else if (nodes[parent].left == node) {
+        nodes[parent].left = child;
+    } else {
+        nodes[parent].right = child;
+    }
+
+    // Its taller child stays with it, the other one moves to the node
+    auto const first = nodes[child].left, second = nodes[child].right;
+    auto const [kept, moved] = nodes[first].height > nodes[second].height
+                                   ? std::pair{first, second}
+                                   : std::pair{second, first};
+    if (nodes[node].left == child) {
+        nodes[node].left = moved;
+    } else {
+        nodes[node].right = moved;
+    }
+    nodes[moved].parent = node;
+
+    nodes[child].left = node;
+    nodes[child].right = kept;
+    nodes[node].parent = child;
+
+    fit(node);
+    fit(child);
+    return child;
+}
+
+void DynamicTree::fit(NodeIndex const node) {
+    auto& fitted = nodes[node];
+    if (fitted.leaf()) {
+        return;
+    }
+
+    auto const& left = nodes[fitted.left];
+    auto const& right = nodes[fitted.right];
+    fitted.min = minimum(left.min, right.min);
+    fitted.max = maximum(left.max, right.max);
+    fitted.height = 1 + std::max(left.height, right.height);
+}
+
+template <typename Function>
+void DynamicTree::query(DirectX::XMFLOAT3 const& min,
+                        DirectX::XMFLOAT3 const& max, Function&& function) {
+    std::vector<NodeIndex> pending;
+    if (root != NO_NODE) {
+        pending.push_back(root);
+    }
+
+    while (!pending.empty()) {
+        auto const index = pending.back();
+        pending.pop_back();
+
+        auto const& node = nodes[index];
+        if (!overlap(node.min, node.max, min, max)) {
+            continue;
+        }
+        if (node.leaf()) {
+            function(index);
+        } else {
+            pending.push_back(node.left);
+            pending.push_back(node.right);
+        }
+    }
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,226 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "BoxBatch.hpp"
+#include "ECS/Utilities.hpp"
+#include "EngineAPI.hpp"
+
+// //////////////////////////////////////////////////////////// Layer matrix //
+// Which of the layers collide with each other, like Unity's layer collision
+// matrix. Every layer collides with all of them until told otherwise
+class ENGINE_API LayerMatrix {
+  public:
+    // ============================================================== Data == //
+    static constexpr unsigned int LAYERS = 32u;
+
+    // ========================================================= Behaviour == //
+    LayerMatrix() { masks.fill(~0u); }
+
+    // Both ways, the colliders on either layer skip the other one
+    void ignore(unsigned int a, unsigned int b);
+
+    // Layers the colliders on the given one collide with
+    std::uint32_t mask(unsigned int layer) const { return masks.at(layer); }
+
+  private:
+    // ============================================================== Data == //
+    std::array<std::uint32_t, LAYERS> masks;
+};
+
+// //////////////////////////////////////////////////////////////// Interface //
+// Finds the pairs of colliders whose boxes may overlap, so that only these
+// are checked precisely. Only the pairs with at least one dynamic collider
+// and accepting each other's layers are reported, each one once, with the
+// smaller identifier first
+class ENGINE_API BroadPhase {
+  public:
+    // ============================================================== Data == //
+    struct Proxy {
+        DirectX::XMFLOAT3 min, max;
+        EntityId entityId;
+        bool dynamic;
+        std::uint32_t layers = 1u, mask = ~0u;
+    };
+    using Pair = std::pair<EntityId, EntityId>;
+    struct Hit {
+        EntityId entityId;
+        float distance;
+    };
+
+    // ========================================================= Behaviour == //
+    virtual ~BroadPhase() = default;
+    virtual void findPairs(std::vector<Proxy> const& proxies,
+                           std::vector<Pair>& pairs) = 0;
+
+    // Queries on the proxies given to the last findPairs call, the ones
+    // without a structure for them check every proxy
+    virtual void overlapBox(std::vector<Proxy> const& proxies,
+                            DirectX::XMFLOAT3 const& min,
+                            DirectX::XMFLOAT3 const& max,
+                            std::function<void(EntityId)> const& visit);
+    virtual std::optional<Hit> raycast(std::vector<Proxy> const& proxies,
+                                       DirectX::XMFLOAT3 const& origin,
+                                       DirectX::XMFLOAT3 const& direction,
+                                       float maxDistance);
+
+  protected:
+    static bool overlap(Proxy const& a, Proxy const& b) {
+        return overlap(a.min, a.max, b.min, b.max);
+    }
+
+    static bool overlap(DirectX::XMFLOAT3 const& aMin,
+                        DirectX::XMFLOAT3 const& aMax,
+                        DirectX::XMFLOAT3 const& bMin,
+                        DirectX::XMFLOAT3 const& bMax) {
+        return aMax.x > bMin.x && aMin.x < bMax.x && aMax.y > bMin.y &&
+               aMin.y < bMax.y && aMax.z > bMin.z && aMin.z < bMax.z;
+    }
+
+    // Distance along the ray to the box, if it's hit before the given one
+    static std::optional<float> intersect(DirectX::XMFLOAT3 const& origin,
+                                          DirectX::XMFLOAT3 const& direction,
+                                          float maxDistance,
+                                          DirectX::XMFLOAT3 const& min,
+                                          DirectX::XMFLOAT3 const& max);
+
+    static bool collide(Proxy const& a, Proxy const& b) {
+        return (a.dynamic || b.dynamic) && (a.layers & b.mask) &&
+               (b.layers & a.mask);
+    }
+
+    static void report(Proxy const& a, Proxy const& b,
+                       std::vector<Pair>& pairs) {
+        if (collide(a, b)) {
+            pairs.push_back(a.entityId < b.entityId
+                                ? Pair{a.entityId, b.entityId}
+                                : Pair{b.entityId, a.entityId});
+        }
+    }
+};
+
+// ////////////////////////////////////////////////////////// Sweep and prune //
+// Sorts the boxes along the X axis, which the level is laid out along, and
+// checks only the ones whose ranges on it overlap. The order is kept between
+// frames, so sorting it again is nearly linear
+class ENGINE_API SweepAndPrune : public BroadPhase {
+  public:
+    // ========================================================= Behaviour == //
+    void findPairs(std::vector<Proxy> const& proxies,
+                   std::vector<Pair>& pairs) override;
+
+  private:
+    // ============================================================== Data == //
+    std::vector<size_t> order;
+    std::vector<size_t> open;
+};
+
+// ///////////////////////////////////////////////////////////// Spatial hash //
+// Puts the boxes into the cells of a uniform grid and checks only the ones
+// sharing a cell. Boxes spanning too many cells are checked against all the
+// others instead, in blocks of them at once
+class ENGINE_API SpatialHash : public BroadPhase {
+  public:
+    // ========================================================= Behaviour == //
+    explicit SpatialHash(float cellSize = 4.0f, size_t maxCellsPerBox = 64u)
+        : cellSize(cellSize), maxCellsPerBox(maxCellsPerBox) {}
+
+    void findPairs(std::vector<Proxy> const& proxies,
+                   std::vector<Pair>& pairs) override;
+
+  private:
+    // ========================================================= Behaviour == //
+    struct Cell {
+        int x, y, z;
+        bool operator==(Cell const& other) const = default;
+    };
+    struct CellHash {
+        size_t operator()(Cell const& cell) const {
+            return static_cast<size_t>(cell.x) * 73856093u ^
+                   static_cast<size_t>(cell.y) * 19349663u ^
+                   static_cast<size_t>(cell.z) * 83492791u;
+        }
+    };
+
+    Cell cell(DirectX::XMFLOAT3 const& point) const;
+
+    // ============================================================== Data == //
+    float cellSize;
+    size_t maxCellsPerBox;
+    std::unordered_map<Cell, std::vector<size_t>, CellHash> cells;
+    std::vector<size_t> large;
+    BoxBatch all;
+};
+
+// ///////////////////////////////////////////////////////////// Dynamic tree //
+// Bounding volume hierarchy kept between frames. The leaves store boxes
+// enlarged by a margin, so colliders moving a little, and the static level
+// geometry which doesn't move at all, don't change the tree. A leaf is
+// reinserted only when its collider leaves the enlarged box. Only dynamic
+// colliders look for their pairs, each one with a single query
+class ENGINE_API DynamicTree : public BroadPhase {
+  public:
+    // ========================================================= Behaviour == //
+    explicit DynamicTree(float margin = 0.25f) : margin(margin) {}
+
+    void findPairs(std::vector<Proxy> const& proxies,
+                   std::vector<Pair>& pairs) override;
+
+    void overlapBox(std::vector<Proxy> const& proxies,
+                    DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max,
+                    std::function<void(EntityId)> const& visit) override;
+    std::optional<Hit> raycast(std::vector<Proxy> const& proxies,
+                               DirectX::XMFLOAT3 const& origin,
+                               DirectX::XMFLOAT3 const& direction,
+                               float maxDistance) override;
+
+  private:
+    // ========================================================= Behaviour == //
+    using NodeIndex = int;
+    static constexpr NodeIndex NO_NODE = -1;
+
+    NodeIndex allocate();
+    void release(NodeIndex node);
+    void insert(NodeIndex leaf);
+    void remove(NodeIndex leaf);
+    void refit(NodeIndex node);
+    NodeIndex balance(NodeIndex node);
+    NodeIndex rotate(NodeIndex node, NodeIndex child);
+    void fit(NodeIndex node);
+
+    template <typename Function>
+    void query(DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max,
+               Function&& function);
+
+    // ============================================================== Data == //
+    struct Node {
+        // Enlarged box for the leaves, union of the children otherwise
+        DirectX::XMFLOAT3 min, max;
+        NodeIndex parent, left, right;
+        int height;
+
+        // Leaves only
+        Proxy proxy;
+        unsigned int frame;
+
+        bool leaf() const { return left == NO_NODE; }
+    };
+
+    float margin;
+    std::vector<Node> nodes;
+    NodeIndex root{NO_NODE};
+    NodeIndex freeNodes{NO_NODE};
+    std::unordered_map<EntityId, NodeIndex> entityToLeaf;
+    unsigned int frame{0};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
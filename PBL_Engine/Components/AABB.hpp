@@ -12,6 +12,11 @@ ECS_COMPONENT(AABB) {
     DirectX::XMVECTOR vertexMin;
     DirectX::XMVECTOR vertexMax;
     std::array<DirectX::XMFLOAT3, 8> vertices;
+
+    // World transform version the bounds were computed for, and how far it
+    // was blended from the pose before the last fixed step
+    ChangeVersion worldVersion = 0;
+    float interpolation = 1.0f;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
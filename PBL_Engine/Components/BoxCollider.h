@@ -3,6 +3,8 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include <DirectXMath.h>
 
+#include <cstdint>
+
 #include "Components/AABB.hpp"
 #include "ECS/Component.hpp"
 
@@ -10,6 +12,10 @@
 ECS_COMPONENT(BoxCollider) {
     DirectX::XMFLOAT3 size, center, separatingVectorSum, numberOfCollisions;
     AABB aabb;
+
+    // Bits of the layers the collider is on and the ones it collides with,
+    // both sides of a pair have to accept each other
+    std::uint32_t layers = 1u, mask = ~0u;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
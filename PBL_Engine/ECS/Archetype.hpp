@@ -0,0 +1,95 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Component.hpp"
+#include "EngineAPI.hpp"
+#include "Utilities.hpp"
+
+// //////////////////////////////////////////////////////////////// Interface //
+class ENGINE_API IArchetypeColumn {
+  public:
+    // ========================================================= Behaviour == //
+    virtual ~IArchetypeColumn() = default;
+
+    // Create an empty column storing the same component type
+    virtual std::unique_ptr<IArchetypeColumn> empty() const = 0;
+
+    // Append the row's element to the end of the destination column
+    virtual void moveRow(size_t row, IArchetypeColumn &destination) = 0;
+
+    // Overwrite the row with the last element and shrink the column
+    virtual void removeRow(size_t row) = 0;
+
+    virtual bool isTag() const = 0;
+    virtual size_t size() const = 0;
+    virtual size_t residentBytes() const = 0;
+};
+
+// /////////////////////////////////////////////////////////////////// Column //
+template <typename Component>
+class ENGINE_API ArchetypeColumn : public IArchetypeColumn {
+  public:
+    // ========================================================= Behaviour == //
+    std::unique_ptr<IArchetypeColumn> empty() const override {
+        return std::make_unique<ArchetypeColumn<Component>>();
+    }
+
+    void moveRow(size_t const row, IArchetypeColumn &destination) override {
+        static_cast<ArchetypeColumn<Component> &>(destination)
+            .components.push_back(std::move(components.at(row)));
+    }
+
+    void removeRow(size_t const row) override {
+        if (row + 1u != components.size()) {
+            components.at(row) = std::move(components.back());
+        }
+        components.pop_back();
+    }
+
+    bool isTag() const override { return std::is_empty_v<Component>; }
+    size_t size() const override { return components.size(); }
+
+    size_t residentBytes() const override {
+        return sizeof(*this) + components.capacity() * sizeof(Component);
+    }
+
+    // ============================================================== Data == //
+    std::vector<Component> components;
+};
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Table of all entities sharing the same set of data components, every
+// component type is kept in its own contiguous column and the entity at the
+// given row owns the elements at the same row in every column
+class ENGINE_API Archetype {
+  public:
+    // ========================================================= Behaviour == //
+    explicit Archetype(Signature const &signature) : signature(signature) {}
+
+    Archetype(Archetype const &) = delete;
+    Archetype(Archetype &&) = delete;
+    Archetype &operator=(Archetype const &) = delete;
+    Archetype &operator=(Archetype &&) = delete;
+
+    template <typename Component>
+    std::vector<Component> &components() {
+        return static_cast<ArchetypeColumn<Component> &>(
+                   *columns.at(ComponentRegistrant::id<Component>()))
+            .components;
+    }
+
+    size_t size() const { return entities.size(); }
+
+    // ============================================================== Data == //
+    Signature const signature;
+    std::vector<EntityId> entities;
+    std::array<std::unique_ptr<IArchetypeColumn>, MAX_COMPONENTS> columns{};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,76 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <functional>
+#include <vector>
+
+#include "ComponentManager.hpp"
+#include "EngineAPI.hpp"
+#include "Utilities.hpp"
+
+// ///////////////////////////////////////////////////// Forward declarations //
+class ENGINE_API Registry;
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Records structural changes of entities, so they can be applied later by the
+// registry in one batch sorted by entity, with every entity's final
+// signature propagated to the systems only once
+class ENGINE_API CommandBuffer {
+  public:
+    // ========================================================= Behaviour == //
+    CommandBuffer() = default;
+
+    CommandBuffer(CommandBuffer const&) = delete;
+    CommandBuffer(CommandBuffer&&) = delete;
+    CommandBuffer& operator=(CommandBuffer const&) = delete;
+    CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+    // --------------------------------------------------------- Record -- == //
+    template <typename ComponentType>
+    void add(EntityId entityId, ComponentType const& component) {
+        commands.push_back(
+            {.type = Type::Add,
+             .entityId = entityId,
+             .componentId = ComponentManager::instance().id<ComponentType>(),
+             .apply = [entityId, component](ComponentManager& manager) {
+                 manager.add<ComponentType>(entityId, component);
+             }});
+    }
+
+    template <typename ComponentType>
+    void remove(EntityId entityId) {
+        commands.push_back(
+            {.type = Type::Remove,
+             .entityId = entityId,
+             .componentId = ComponentManager::instance().id<ComponentType>(),
+             .apply = [entityId](ComponentManager& manager) {
+                 manager.remove<ComponentType>(entityId);
+             }});
+    }
+
+    void destroy(EntityId entityId) {
+        commands.push_back({.type = Type::Destroy,
+                            .entityId = entityId,
+                            .componentId = EMPTY_COMPONENT,
+                            .apply = nullptr});
+    }
+
+    bool empty() const { return commands.empty(); }
+
+  private:
+    friend Registry;
+
+    // ============================================================== Data == //
+    enum class Type { Add, Remove, Destroy };
+
+    struct Command {
+        Type type;
+        EntityId entityId;
+        ComponentId componentId;
+        std::function<void(ComponentManager&)> apply;
+    };
+
+    std::vector<Command> commands;
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
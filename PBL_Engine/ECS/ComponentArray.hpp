@@ -3,9 +3,11 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include <array>
 #include <cassert>
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 #include "EngineAPI.hpp"
+#include "SparseIndex.hpp"
 #include "Utilities.hpp"
 
 // //////////////////////////////////////////////////////////////// Interface //
@@ -14,18 +16,18 @@ class ENGINE_API IComponentArray {
     // ========================================================= Behaviour == //
     virtual ~IComponentArray() = default;
     virtual void destroyEntity(EntityId entityId) = 0;
+    virtual size_t count() const = 0;
+    virtual size_t residentBytes() const = 0;
 };
 
 // //////////////////////////////////////////////////////////////////// Class //
+// Components are packed at the front of the storage, which grows one page at
+// a time, so references to them stay valid while new ones are inserted.
+// Every component remembers the version of the array in which it was last
+// inserted or accessed mutably, so systems can visit only the changed ones
 template <typename Component>
 class ENGINE_API ComponentArray : public IComponentArray {
   public:
-    ComponentArray() {
-        size = 0;
-        indicies.fill(EMPTY_ENTITY);
-        entities.fill(EMPTY_ENTITY);
-    }
-
     // ========================================================= Behaviour == //
     void insert(EntityId const entityId, Component const &component) {
         if (componentExists(entityId)) {
@@ -33,20 +35,21 @@ class ENGINE_API ComponentArray : public IComponentArray {
             return;
         }
 
-        if (size > MAX_ENTITIES) {
-            return;
-        }
+        assert(entityId < MAX_ENTITIES &&
+               "Entity identifier must be in range [0, MAX_ENTITIES)!");
 
-        auto const insertedIndex = size;
-        auto const insertedEntityId = entityId;
+        auto const insertedIndex = size();
 
         // Insert new element at the end of the array
-        components.at(insertedIndex) = component;
-        ++size;
+        if (insertedIndex / PAGE_SIZE == pages.size()) {
+            pages.push_back(std::make_unique<Page>());
+        }
+        at(insertedIndex) = component;
 
         // Update mappings
-        indicies.at(entityId) = insertedIndex;
-        entities.at(insertedIndex) = entityId;
+        indicies.set(entityId, static_cast<EntityId>(insertedIndex));
+        entities.push_back(entityId);
+        versions.push_back(version);
     }
 
     void remove(EntityId const entityId) {
@@ -54,45 +57,107 @@ class ENGINE_API ComponentArray : public IComponentArray {
             return;
         }
 
-        auto const lastIndex = size - 1u;
-        auto const removedIndex = indicies.at(entityId);
-        auto const lastEntityId = entities.at(lastIndex);
+        auto const lastIndex = size() - 1u;
+        auto const removedIndex = indicies.get(entityId);
+        auto const lastEntityId = entities.back();
         auto const removedEntityId = entityId;
 
         // Overwrite the removed element with the last one
-        components.at(removedIndex) = components.at(lastIndex);
-        --size;
+        at(removedIndex) = at(lastIndex);
 
         // Update mappings
-        indicies.at(lastEntityId) = removedIndex;
+        indicies.set(lastEntityId, removedIndex);
         entities.at(removedIndex) = lastEntityId;
-        indicies.at(removedEntityId) = EMPTY_ENTITY;
-        entities.at(lastIndex) = EMPTY_ENTITY;
+        versions.at(removedIndex) = versions.back();
+        indicies.reset(removedEntityId);
+        entities.pop_back();
+        versions.pop_back();
     }
 
     Component &get(EntityId const entityId) {
         assert(componentExists(entityId) &&
                "Component doesn't exist for given entity!");
 
-        return components.at(indicies.at(entityId));
+        auto const index = indicies.get(entityId);
+        versions[index] = version;
+        return at(index);
+    }
+
+    // Read access, which doesn't count as a change
+    Component const &peek(EntityId const entityId) {
+        assert(componentExists(entityId) &&
+               "Component doesn't exist for given entity!");
+
+        return at(indicies.get(entityId));
+    }
+
+    // Marks the component as changed, for writes done through views or
+    // pointers kept between frames
+    void patch(EntityId const entityId) {
+        assert(componentExists(entityId) &&
+               "Component doesn't exist for given entity!");
+
+        versions[indicies.get(entityId)] = version;
+    }
+
+    // Calls the function with the identifier of every entity whose component
+    // changed after the given version, the returned version should be passed
+    // on the next call to get only the changes made since this one
+    template <typename Function>
+    ChangeVersion eachChanged(ChangeVersion const since, Function &&function) {
+        auto const current = version++;
+        for (size_t i = 0; i < versions.size(); ++i) {
+            if (versions[i] > since) {
+                function(entities[i]);
+            }
+        }
+        return current;
     }
 
     bool contains(EntityId const entityId) { return componentExists(entityId); }
 
+    // Unchecked lookup for iteration, returns nullptr for missing component
+    Component *find(EntityId const entityId) {
+        auto const index = indicies.get(entityId);
+        return index != EMPTY_ENTITY ? &at(index) : nullptr;
+    }
+
+    size_t count() const override { return size(); }
+    std::vector<EntityId> const &entityIds() const { return entities; }
+
+    size_t residentBytes() const override {
+        return sizeof(*this) + indicies.residentBytes() +
+               entities.capacity() * sizeof(EntityId) +
+               versions.capacity() * sizeof(ChangeVersion) +
+               pages.capacity() * sizeof(std::unique_ptr<Page>) +
+               pages.size() * sizeof(Page);
+    }
+
     void destroyEntity(EntityId const entityId) override { remove(entityId); }
 
   private:
     // ========================================================= Behaviour == //
     bool componentExists(EntityId const &entityId) {
-        return indicies.at(entityId) != EMPTY_ENTITY;
+        return indicies.get(entityId) != EMPTY_ENTITY;
+    }
+
+    size_t size() const { return entities.size(); }
+
+    Component &at(size_t const index) {
+        return (*pages[index / PAGE_SIZE])[index % PAGE_SIZE];
     }
 
     // ============================================================== Data == //
-    std::array<Component, MAX_ENTITIES> components{};
-    size_t size{0};
+    static constexpr size_t PAGE_SIZE = 256u;
+    using Page = std::array<Component, PAGE_SIZE>;
+
+    std::vector<std::unique_ptr<Page>> pages;
+
+    SparseIndex indicies;
+    std::vector<EntityId> entities;
 
-    std::array<size_t, MAX_ENTITIES> indicies{};
-    std::array<EntityId, MAX_ENTITIES> entities{};
+    std::vector<ChangeVersion> versions;
+    ChangeVersion version{1};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -11,11 +11,21 @@ ComponentManager& ComponentManager::instance() {
 
 // ------------------------------------------------------------ Helpers -- == //
 void ComponentManager::destroyEntity(EntityId const entityId) {
-    for (auto const& components : componentArrays) {
-        if (components) {
-            components->destroyEntity(entityId);
+    storage.destroyEntity(entityId);
+}
+
+// -------------------------------------------------------------- Stats -- == //
+std::vector<ComponentManager::ComponentMemory>
+ComponentManager::memoryReport() {
+    std::vector<ComponentMemory> report;
+    for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (storage.isComponentTypeRegistered(id)) {
+            report.push_back({.name = names.at(id),
+                              .count = storage.count(id),
+                              .residentBytes = storage.residentBytes(id)});
         }
     }
+    return report;
 }
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -8,9 +8,11 @@
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Component.hpp"
-#include "ComponentArray.hpp"
+#include "ComponentStorage.hpp"
 #include "EngineAPI.hpp"
 #include "Utilities.hpp"
 
@@ -48,8 +50,8 @@ class ENGINE_API ComponentManager {
             throw;
         }
 
-        componentArrays.at(id<ComponentType>()) =
-            std::make_shared<ComponentArray<ComponentType>>();
+        storage.registerComponentType<ComponentType>();
+        names.at(id<ComponentType>()) = typeid(ComponentType).name();
     }
 
     template <typename ComponentType>
@@ -63,27 +65,66 @@ class ENGINE_API ComponentManager {
     // --------------------------------------------- Main functionality -- == //
     template <typename ComponentType>
     void add(EntityId entityId, ComponentType const& component) {
-        components<ComponentType>()->insert(entityId, component);
+        checkComponentType<ComponentType>();
+        storage.insert<ComponentType>(entityId, component);
     }
 
     template <typename ComponentType>
     void remove(EntityId entityId) {
-        components<ComponentType>()->remove(entityId);
+        checkComponentType<ComponentType>();
+        storage.remove<ComponentType>(entityId);
     }
 
     template <typename ComponentType>
     ComponentType& get(EntityId entityId) {
-        return components<ComponentType>()->get(entityId);
+        checkComponentType<ComponentType>();
+        return storage.get<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType>
+    ComponentType const& peek(EntityId entityId) {
+        checkComponentType<ComponentType>();
+        return storage.peek<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType>
+    void patch(EntityId entityId) {
+        checkComponentType<ComponentType>();
+        storage.patch<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType, typename Function>
+    ChangeVersion eachChanged(ChangeVersion since, Function&& function) {
+        checkComponentType<ComponentType>();
+        return storage.eachChanged<ComponentType>(
+            since, std::forward<Function>(function));
     }
 
     template <typename ComponentType>
     bool has(EntityId entityId) {
-        return components<ComponentType>()->contains(entityId);
+        checkComponentType<ComponentType>();
+        return storage.contains<ComponentType>(entityId);
+    }
+
+    template <typename... ComponentTypes>
+    auto view() {
+        (checkComponentType<ComponentTypes>(), ...);
+        return storage.view<ComponentTypes...>();
     }
 
     // -------------------------------------------------------- Helpers -- == //
     void destroyEntity(EntityId entityId);
 
+    // ---------------------------------------------------------- Stats -- == //
+    struct ComponentMemory {
+        char const* name;
+        size_t count;
+        size_t residentBytes;
+    };
+
+    // Memory held by every registered component type
+    std::vector<ComponentMemory> memoryReport();
+
   private:
     // ========================================================= Behaviour == //
     // ------------------------------------------------------ Singleton -- == //
@@ -91,30 +132,31 @@ class ENGINE_API ComponentManager {
     ~ComponentManager() = default;
 
     // --------------------------------------------------- Registration -- == //
+    // These can't go through id(), which asserts both of them
     template <typename ComponentType>
     bool isComponentIdSet() {
-        return id<ComponentType>() != EMPTY_COMPONENT;
+        return ComponentRegistrant::id<ComponentType>() != EMPTY_COMPONENT;
     }
 
     template <typename ComponentType>
     bool isComponentTypeRegistered() {
-        return componentArrays.at(id<ComponentType>()) != nullptr;
+        return storage.isComponentTypeRegistered(
+            ComponentRegistrant::id<ComponentType>());
     }
 
     // -------------------------------------------------------- Helpers -- == //
+    // The storage doesn't check the types it's given, an unregistered one
+    // would be looked up in an empty slot
     template <typename ComponentType>
-    std::shared_ptr<ComponentArray<ComponentType>> components() {
+    void checkComponentType() {
         ASSERT_COMPONENT_ID_SET();
         ASSERT_COMPONENT_TYPE_REGISTERED();
-
-        return std::static_pointer_cast<ComponentArray<ComponentType>>(
-            componentArrays.at(id<ComponentType>()));
     }
 
     // ============================================================== Data == //
     size_t numberOfRegisteredComponents{0};
-    std::array<std::shared_ptr<IComponentArray>, MAX_COMPONENTS>
-        componentArrays{};
+    ComponentStorage storage;
+    std::array<char const*, MAX_COMPONENTS> names{};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,125 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "ComponentStorage.hpp"
+
+// ////////////////////////////////////////////////////// Per-type arrays mode //
+// ============================================================= Behaviour == //
+void ComponentArrayStorage::destroyEntity(EntityId const entityId) {
+    for (auto const& components : componentArrays) {
+        if (components) {
+            components->destroyEntity(entityId);
+        }
+    }
+}
+
+size_t ComponentArrayStorage::count(ComponentId const componentId) {
+    auto const& components = componentArrays.at(componentId);
+    return components ? components->count() : 0u;
+}
+
+size_t ComponentArrayStorage::residentBytes(ComponentId const componentId) {
+    auto const& components = componentArrays.at(componentId);
+    return components ? components->residentBytes() : 0u;
+}
+
+// /////////////////////////////////////////////////////////// Archetype mode //
+// ============================================================= Behaviour == //
+void ArchetypeStorage::destroyEntity(EntityId const entityId) {
+    if (entityId >= locations.size()) {
+        return;
+    }
+
+    if (auto const [source, row, tags] = locations[entityId]; source) {
+        erase(*source, row);
+    }
+    locations[entityId] = {};
+}
+
+size_t ArchetypeStorage::count(ComponentId const componentId) {
+    size_t result = 0;
+    if (prototypes.at(componentId) && prototypes.at(componentId)->isTag()) {
+        for (auto const& location : locations) {
+            result += location.tags.test(componentId);
+        }
+        return result;
+    }
+    for (auto const& archetype : archetypes) {
+        if (archetype->signature.test(componentId)) {
+            result += archetype->size();
+        }
+    }
+    return result;
+}
+
+size_t ArchetypeStorage::residentBytes(ComponentId const componentId) {
+    size_t result =
+        versions.at(componentId).capacity() * sizeof(ChangeVersion);
+    for (auto const& archetype : archetypes) {
+        if (archetype->signature.test(componentId)) {
+            result += archetype->columns.at(componentId)->residentBytes();
+        }
+    }
+    return result;
+}
+
+void ArchetypeStorage::relocate(EntityId const entityId,
+                                Signature const& signature) {
+    auto& destination = archetype(signature);
+    auto const [source, row, tags] = locations.at(entityId);
+
+    if (source == &destination) {
+        return;
+    }
+
+    // Move the shared components and the entity to the end of destination
+    if (source) {
+        for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+            if (source->signature.test(id) && signature.test(id)) {
+                source->columns.at(id)->moveRow(row, *destination.columns[id]);
+            }
+        }
+    }
+    destination.entities.push_back(entityId);
+
+    if (source) {
+        erase(*source, row);
+    }
+
+    locations.at(entityId).archetype = &destination;
+    locations.at(entityId).row = destination.size() - 1u;
+}
+
+void ArchetypeStorage::erase(Archetype& archetype, size_t const row) {
+    // Fill the hole with the archetype's last row
+    for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (archetype.signature.test(id)) {
+            archetype.columns.at(id)->removeRow(row);
+        }
+    }
+
+    auto const lastEntityId = archetype.entities.back();
+    archetype.entities.at(row) = lastEntityId;
+    archetype.entities.pop_back();
+    locations.at(lastEntityId).row = row;
+}
+
+Archetype& ArchetypeStorage::archetype(Signature const& signature) {
+    if (auto it = signatureToArchetype.find(signature);
+        it != signatureToArchetype.end()) {
+        return *it->second;
+    }
+
+    auto& created =
+        archetypes.emplace_back(std::make_unique<Archetype>(signature));
+    for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (signature.test(id)) {
+            assert(prototypes.at(id) &&
+                   "Component type must be registered before use!");
+            created->columns.at(id) = prototypes.at(id)->empty();
+        }
+    }
+    signatureToArchetype.insert({signature, created.get()});
+
+    return *created;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
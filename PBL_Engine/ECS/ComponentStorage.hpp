@@ -0,0 +1,435 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <array>
+#include <cassert>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Archetype.hpp"
+#include "Component.hpp"
+#include "ComponentArray.hpp"
+#include "EngineAPI.hpp"
+#include "Utilities.hpp"
+#include "View.hpp"
+
+// ////////////////////////////////////////////////////// Per-type arrays mode //
+// Every component type lives in its own array, indexed through the entity
+class ENGINE_API ComponentArrayStorage {
+  public:
+    // ========================================================= Behaviour == //
+    // --------------------------------------------------- Registration -- == //
+    template <typename ComponentType>
+    void registerComponentType() {
+        componentArrays.at(ComponentRegistrant::id<ComponentType>()) =
+            std::make_shared<ComponentArray<ComponentType>>();
+    }
+
+    bool isComponentTypeRegistered(ComponentId const componentId) {
+        return componentArrays.at(componentId) != nullptr;
+    }
+
+    // --------------------------------------------- Main functionality -- == //
+    template <typename ComponentType>
+    void insert(EntityId entityId, ComponentType const& component) {
+        components<ComponentType>()->insert(entityId, component);
+    }
+
+    template <typename ComponentType>
+    void remove(EntityId entityId) {
+        components<ComponentType>()->remove(entityId);
+    }
+
+    template <typename ComponentType>
+    ComponentType& get(EntityId entityId) {
+        return components<ComponentType>()->get(entityId);
+    }
+
+    template <typename ComponentType>
+    ComponentType const& peek(EntityId entityId) {
+        return components<ComponentType>()->peek(entityId);
+    }
+
+    template <typename ComponentType>
+    void patch(EntityId entityId) {
+        components<ComponentType>()->patch(entityId);
+    }
+
+    template <typename ComponentType, typename Function>
+    ChangeVersion eachChanged(ChangeVersion since, Function&& function) {
+        return components<ComponentType>()->eachChanged(
+            since, std::forward<Function>(function));
+    }
+
+    template <typename ComponentType>
+    bool contains(EntityId entityId) {
+        return components<ComponentType>()->contains(entityId);
+    }
+
+    void destroyEntity(EntityId entityId);
+
+    // ---------------------------------------------------------- Stats -- == //
+    size_t count(ComponentId componentId);
+    size_t residentBytes(ComponentId componentId);
+
+    // ------------------------------------------------------ Iteration -- == //
+    // Walks the smallest of the requested arrays and looks the entity up in
+    // the remaining ones
+    template <typename... ComponentTypes>
+    class Cursor {
+      public:
+        static_assert(sizeof...(ComponentTypes) > 0,
+                      "View must request at least one component type!");
+
+        explicit Cursor(ComponentArray<ComponentTypes> *... arrays)
+            : arrays{arrays...} {
+            auto const consider = [this](auto const *array) {
+                if (!entities || array->count() < entities->size()) {
+                    entities = &array->entityIds();
+                }
+            };
+            (consider(arrays), ...);
+            seek();
+        }
+
+        bool done() const { return index >= entities->size(); }
+
+        void advance() {
+            ++index;
+            seek();
+        }
+
+        std::tuple<EntityId, ComponentTypes &...> current() const {
+            return {(*entities)[index],
+                    *std::get<ComponentTypes *>(elements)...};
+        }
+
+      private:
+        void seek() {
+            for (; index < entities->size(); ++index) {
+                auto const entityId = (*entities)[index];
+                elements = {
+                    std::get<ComponentArray<ComponentTypes> *>(arrays)->find(
+                        entityId)...};
+                if ((std::get<ComponentTypes *>(elements) && ...)) {
+                    return;
+                }
+            }
+        }
+
+        std::tuple<ComponentArray<ComponentTypes> *...> arrays;
+        std::tuple<ComponentTypes *...> elements{};
+        std::vector<EntityId> const *entities{nullptr};
+        size_t index{0};
+    };
+
+    template <typename... ComponentTypes>
+    View<Cursor<ComponentTypes...>> view() {
+        return View{Cursor<ComponentTypes...>{
+            components<ComponentTypes>().get()...}};
+    }
+
+  private:
+    // ========================================================= Behaviour == //
+    template <typename ComponentType>
+    std::shared_ptr<ComponentArray<ComponentType>> components() {
+        return std::static_pointer_cast<ComponentArray<ComponentType>>(
+            componentArrays.at(ComponentRegistrant::id<ComponentType>()));
+    }
+
+    // ============================================================== Data == //
+    std::array<std::shared_ptr<IComponentArray>, MAX_COMPONENTS>
+        componentArrays{};
+};
+
+// /////////////////////////////////////////////////////////// Archetype mode //
+// Entities with the same set of data components are kept together in one
+// archetype, so iterating over several component types at once is a linear
+// scan through contiguous columns. Tags (empty component types) don't take
+// part in the archetype's signature, which means toggling them never moves
+// any data. Adding or removing a data component moves the entity's row into
+// another archetype and invalidates references to its components.
+class ENGINE_API ArchetypeStorage {
+  public:
+    // ========================================================= Behaviour == //
+    ArchetypeStorage() = default;
+
+    ArchetypeStorage(ArchetypeStorage const&) = delete;
+    ArchetypeStorage(ArchetypeStorage&&) = delete;
+    ArchetypeStorage& operator=(ArchetypeStorage const&) = delete;
+    ArchetypeStorage& operator=(ArchetypeStorage&&) = delete;
+
+    // --------------------------------------------------- Registration -- == //
+    template <typename ComponentType>
+    void registerComponentType() {
+        prototypes.at(ComponentRegistrant::id<ComponentType>()) =
+            std::make_unique<ArchetypeColumn<ComponentType>>();
+    }
+
+    bool isComponentTypeRegistered(ComponentId const componentId) {
+        return prototypes.at(componentId) != nullptr;
+    }
+
+    // --------------------------------------------- Main functionality -- == //
+    template <typename ComponentType>
+    void insert(EntityId entityId, ComponentType const& component) {
+        auto const componentId = ComponentRegistrant::id<ComponentType>();
+
+        if (entityId >= locations.size()) {
+            assert(entityId < MAX_ENTITIES &&
+                   "Entity identifier must be in range [0, MAX_ENTITIES)!");
+            locations.resize(entityId + 1u);
+        }
+        if (!locations[entityId].archetype) {
+            relocate(entityId, Signature{});
+        }
+
+        stamp(componentId, entityId);
+        if constexpr (std::is_empty_v<ComponentType>) {
+            locations[entityId].tags.set(componentId);
+        } else if (contains<ComponentType>(entityId)) {
+            get<ComponentType>(entityId) = component;
+        } else {
+            auto signature = locations.at(entityId).archetype->signature;
+            relocate(entityId, signature.set(componentId));
+            locations.at(entityId)
+                .archetype->components<ComponentType>()
+                .push_back(component);
+        }
+    }
+
+    template <typename ComponentType>
+    void remove(EntityId entityId) {
+        if (!contains<ComponentType>(entityId)) {
+            return;
+        }
+
+        auto const componentId = ComponentRegistrant::id<ComponentType>();
+
+        if constexpr (std::is_empty_v<ComponentType>) {
+            locations[entityId].tags.reset(componentId);
+        } else {
+            auto signature = locations.at(entityId).archetype->signature;
+            relocate(entityId, signature.reset(componentId));
+        }
+    }
+
+    template <typename ComponentType>
+    ComponentType& get(EntityId entityId) {
+        assert(contains<ComponentType>(entityId) &&
+               "Component doesn't exist for given entity!");
+
+        stamp(ComponentRegistrant::id<ComponentType>(), entityId);
+        return at<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType>
+    ComponentType const& peek(EntityId entityId) {
+        assert(contains<ComponentType>(entityId) &&
+               "Component doesn't exist for given entity!");
+
+        return at<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType>
+    void patch(EntityId entityId) {
+        assert(contains<ComponentType>(entityId) &&
+               "Component doesn't exist for given entity!");
+
+        stamp(ComponentRegistrant::id<ComponentType>(), entityId);
+    }
+
+    // Versions are kept per entity, as the rows move between archetypes
+    template <typename ComponentType, typename Function>
+    ChangeVersion eachChanged(ChangeVersion const since, Function&& function) {
+        auto const componentId = ComponentRegistrant::id<ComponentType>();
+        auto const& changes = versions[componentId];
+
+        auto const current = currentVersions[componentId]++;
+        for (EntityId entityId = 0; entityId < changes.size(); ++entityId) {
+            if (changes[entityId] > since &&
+                contains<ComponentType>(entityId)) {
+                function(entityId);
+            }
+        }
+        return current;
+    }
+
+    template <typename ComponentType>
+    bool contains(EntityId entityId) {
+        auto const componentId = ComponentRegistrant::id<ComponentType>();
+        if (entityId >= locations.size()) {
+            return false;
+        }
+
+        auto const& location = locations[entityId];
+        if constexpr (std::is_empty_v<ComponentType>) {
+            return location.tags.test(componentId);
+        } else {
+            return location.archetype &&
+                   location.archetype->signature.test(componentId);
+        }
+    }
+
+    void destroyEntity(EntityId entityId);
+
+    // ---------------------------------------------------------- Stats -- == //
+    // Tags are only bits in the entities' locations, so they take no memory
+    // of their own
+    size_t count(ComponentId componentId);
+    size_t residentBytes(ComponentId componentId);
+
+    // ------------------------------------------------------ Iteration -- == //
+    // Walks the rows of every archetype containing the requested data
+    // components, skipping the entities that miss any of the requested tags
+    template <typename... ComponentTypes>
+    class Cursor {
+      public:
+        static_assert(sizeof...(ComponentTypes) > 0,
+                      "View must request at least one component type!");
+
+        explicit Cursor(ArchetypeStorage &storage) : storage(&storage) {
+            (require<ComponentTypes>(required, requiredTags), ...);
+            seek();
+        }
+
+        bool done() const { return archetype >= storage->archetypes.size(); }
+
+        void advance() {
+            ++row;
+            seek();
+        }
+
+        std::tuple<EntityId, ComponentTypes &...> current() const {
+            return {storage->archetypes[archetype]->entities[row],
+                    element<ComponentTypes>(
+                        std::get<ComponentTypes *>(columns), row)...};
+        }
+
+      private:
+        void seek() {
+            for (; archetype < storage->archetypes.size();
+                 ++archetype, row = 0) {
+                auto &candidate = *storage->archetypes[archetype];
+                if ((candidate.signature & required) != required) {
+                    continue;
+                }
+                if (row == 0) {
+                    columns = {column<ComponentTypes>(candidate)...};
+                }
+                for (; row < candidate.size(); ++row) {
+                    auto const entityId = candidate.entities[row];
+                    if ((storage->locations[entityId].tags & requiredTags) ==
+                        requiredTags) {
+                        return;
+                    }
+                }
+            }
+        }
+
+        ArchetypeStorage *storage;
+        Signature required, requiredTags;
+        std::tuple<ComponentTypes *...> columns{};
+        size_t archetype{0};
+        size_t row{0};
+    };
+
+    template <typename... ComponentTypes>
+    View<Cursor<ComponentTypes...>> view() {
+        return View{Cursor<ComponentTypes...>{*this}};
+    }
+
+  private:
+    // ========================================================= Behaviour == //
+    template <typename ComponentType>
+    ComponentType& at(EntityId const entityId) {
+        if constexpr (std::is_empty_v<ComponentType>) {
+            return tag<ComponentType>();
+        } else {
+            auto const& location = locations.at(entityId);
+            return location.archetype->components<ComponentType>().at(
+                location.row);
+        }
+    }
+
+    void stamp(ComponentId const componentId, EntityId const entityId) {
+        auto& changes = versions[componentId];
+        if (entityId >= changes.size()) {
+            changes.resize(entityId + 1u, 0u);
+        }
+        changes[entityId] = currentVersions[componentId];
+    }
+
+    // Move the entity's row into the archetype with given signature
+    void relocate(EntityId entityId, Signature const& signature);
+    void erase(Archetype& archetype, size_t row);
+    Archetype& archetype(Signature const& signature);
+
+    template <typename ComponentType>
+    static ComponentType& tag() {
+        static ComponentType instance{};
+        return instance;
+    }
+
+    template <typename ComponentType>
+    static void require(Signature& required, Signature& requiredTags) {
+        if constexpr (std::is_empty_v<ComponentType>) {
+            requiredTags.set(ComponentRegistrant::id<ComponentType>());
+        } else {
+            required.set(ComponentRegistrant::id<ComponentType>());
+        }
+    }
+
+    template <typename ComponentType>
+    static ComponentType* column(Archetype& archetype) {
+        if constexpr (std::is_empty_v<ComponentType>) {
+            return &tag<ComponentType>();
+        } else {
+            return archetype.components<ComponentType>().data();
+        }
+    }
+
+    template <typename ComponentType>
+    static ComponentType& element(ComponentType* column, size_t const row) {
+        if constexpr (std::is_empty_v<ComponentType>) {
+            return *column;
+        } else {
+            return column[row];
+        }
+    }
+
+    // ============================================================== Data == //
+    struct Location {
+        Archetype* archetype{nullptr};
+        size_t row{0};
+        Signature tags{};
+    };
+
+    std::array<std::unique_ptr<IArchetypeColumn>, MAX_COMPONENTS> prototypes{};
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<Signature, Archetype*> signatureToArchetype;
+
+    std::vector<Location> locations;
+
+    std::array<std::vector<ChangeVersion>, MAX_COMPONENTS> versions{};
+    std::array<ChangeVersion, MAX_COMPONENTS> currentVersions = [] {
+        std::array<ChangeVersion, MAX_COMPONENTS> initial;
+        initial.fill(1u);
+        return initial;
+    }();
+};
+
+// ///////////////////////////////////////////////////////// Storage selection //
+// Define ECS_ARCHETYPE_STORAGE in the project's preprocessor definitions to
+// switch all component storage into the archetype mode
+#ifdef ECS_ARCHETYPE_STORAGE
+using ComponentStorage = ArchetypeStorage;
+#else
+using ComponentStorage = ComponentArrayStorage;
+#endif
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -9,11 +9,14 @@ class ENGINE_API Entity {
   public:
     // ========================================================= Behaviour == //
     Entity(EntityId entityId) : id(entityId) {}
+    Entity(EntityHandle handle) : id(handle.id()) {}
 
     friend bool operator<(Entity const& a, Entity const& b) {
         return a.id < b.id;
     }
 
+    EntityHandle handle() const { return registry.handle(id); }
+
     template <typename ComponentType>
     Entity& add(ComponentType const& component) {
         registry.addComponent(id, component);
@@ -33,7 +36,7 @@ class ENGINE_API Entity {
 
     template <typename ComponentType>
     ComponentType const& get() const {
-        return registry.component<ComponentType>(id);
+        return registry.peek<ComponentType>(id);
     }
 
     template <typename ComponentType>
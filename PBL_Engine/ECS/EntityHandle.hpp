@@ -0,0 +1,35 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cstdint>
+
+#include "EngineAPI.hpp"
+#include "Utilities.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Entity identifier packed together with the generation of its slot, which
+// changes every time the entity gets destroyed, so handles kept for longer
+// than a frame can tell whether they still refer to the same entity. Default
+// constructed handles are null and never valid
+struct ENGINE_API EntityHandle {
+    // ========================================================= Behaviour == //
+    EntityHandle() = default;
+    EntityHandle(EntityId const entityId, unsigned int const generation)
+        : value((static_cast<std::uint32_t>(generation) << ENTITY_INDEX_BITS) |
+                entityId) {}
+
+    EntityId id() const { return value & ENTITY_INDEX_MASK; }
+    unsigned int generation() const { return value >> ENTITY_INDEX_BITS; }
+
+    friend bool operator==(EntityHandle const &a, EntityHandle const &b) {
+        return a.value == b.value;
+    }
+    friend bool operator!=(EntityHandle const &a, EntityHandle const &b) {
+        return a.value != b.value;
+    }
+
+    // ============================================================== Data == //
+    std::uint32_t value{NULL_ENTITY};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
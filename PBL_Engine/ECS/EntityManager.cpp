@@ -13,42 +13,80 @@ EntityManager& EntityManager::instance() {
 
 // ------------------------------------------------- Main functionality -- == //
 EntityId EntityManager::create() {
-    assert(availableIdentifiers.size() > 0 && "Cannot create more entities!");
+    EntityId entityId;
+    if (numberOfAvailable > MINIMUM_AVAILABLE_IDENTIFIERS ||
+        (nextIdentifier == MAX_ENTITIES && numberOfAvailable > 0)) {
+        entityId = firstAvailable;
+        firstAvailable = nextAvailable[entityId];
+        --numberOfAvailable;
+        if (numberOfAvailable == 0) {
+            lastAvailable = EMPTY_ENTITY;
+        }
+    } else {
+        assert(nextIdentifier < MAX_ENTITIES && "Cannot create more entities!");
 
-    EntityId entityId = availableIdentifiers.front();
-    availableIdentifiers.pop();
+        entityId = nextIdentifier++;
+        nextAvailable.push_back(EMPTY_ENTITY);
+        generations.push_back(0);
+        alive.push_back(false);
+        signatures.emplace_back();
+    }
 
+    alive[entityId] = true;
     return entityId;
 }
 
 void EntityManager::destroy(EntityId entityId) {
-    assert((entityId >= 0 && entityId < MAX_ENTITIES) &&
+    assert((entityId >= 0 && entityId < nextIdentifier) &&
            "Entity identifier must be in range [0, MAX_ENTITIES)!");
 
+    if (!alive[entityId]) {
+        return;
+    }
+
     signatures[entityId].reset();
-    availableIdentifiers.push(entityId);
+    alive[entityId] = false;
+    generations[entityId] =
+        (generations[entityId] + 1u) & ((1u << ENTITY_GENERATION_BITS) - 1u);
+
+    // Append the identifier to the end of the list
+    nextAvailable[entityId] = EMPTY_ENTITY;
+    if (numberOfAvailable == 0) {
+        firstAvailable = entityId;
+    } else {
+        nextAvailable[lastAvailable] = entityId;
+    }
+    lastAvailable = entityId;
+    ++numberOfAvailable;
 }
 
 void EntityManager::setSignature(EntityId entityId,
                                  Signature const& signature) {
-    assert((entityId >= 0 && entityId < MAX_ENTITIES) &&
+    assert((entityId >= 0 && entityId < nextIdentifier) &&
            "Entity identifier must be in range [0, MAX_ENTITIES)!");
 
     signatures[entityId] = signature;
 }
 
 Signature EntityManager::getSignature(EntityId entityId) {
-    assert((entityId >= 0 && entityId < MAX_ENTITIES) &&
+    assert((entityId >= 0 && entityId < nextIdentifier) &&
            "Entity identifier must be in range [0, MAX_ENTITIES)!");
 
     return signatures[entityId];
 }
 
-// ---------------------------------------------------------- Singleton -- == //
-EntityManager::EntityManager() {
-    for (EntityId id = 0; id < MAX_ENTITIES; ++id) {
-        availableIdentifiers.push(id);
-    }
+// ------------------------------------------------------------ Handles -- == //
+EntityHandle EntityManager::handle(EntityId entityId) const {
+    assert((entityId >= 0 && entityId < nextIdentifier) &&
+           "Entity identifier must be in range [0, MAX_ENTITIES)!");
+
+    return {entityId, generations[entityId]};
+}
+
+bool EntityManager::valid(EntityHandle const handle) const {
+    auto const entityId = handle.id();
+    return entityId < nextIdentifier && alive[entityId] &&
+           generations[entityId] == handle.generation();
 }
 
 // ////////////////////////////////////////////////////////////////////////// //
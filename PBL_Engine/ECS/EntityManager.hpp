@@ -1,10 +1,11 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
-#include <array>
-#include <queue>
+#include <cstdint>
+#include <vector>
 
 #include "EngineAPI.hpp"
+#include "EntityHandle.hpp"
 #include "Utilities.hpp"
 
 // //////////////////////////////////////////////////////////////////// Class //
@@ -26,15 +27,30 @@ class ENGINE_API EntityManager {
     void setSignature(EntityId entityId, Signature const& signature);
     Signature getSignature(EntityId entityId);
 
+    // ------------------------------------------------------- Handles -- == //
+    EntityHandle handle(EntityId entityId) const;
+    bool valid(EntityHandle handle) const;
+
   private:
     // ========================================================= Behaviour == //
     // ------------------------------------------------------ Singleton -- == //
-    EntityManager();
+    EntityManager() = default;
     ~EntityManager() = default;
 
     // ============================================================== Data == //
-    std::queue<EntityId> availableIdentifiers{};
-    std::array<Signature, MAX_ENTITIES> signatures{};
+    // Destroyed identifiers wait in a FIFO list threaded through
+    // nextAvailable and are reused only once enough of them pile up, so a
+    // slot's generation doesn't wrap around quickly
+    static constexpr EntityId MINIMUM_AVAILABLE_IDENTIFIERS = 1024u;
+
+    EntityId nextIdentifier{0};
+    EntityId firstAvailable{EMPTY_ENTITY}, lastAvailable{EMPTY_ENTITY};
+    EntityId numberOfAvailable{0};
+    std::vector<EntityId> nextAvailable{};
+
+    std::vector<std::uint16_t> generations{};
+    std::vector<bool> alive{};
+    std::vector<Signature> signatures{};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,128 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "EntitySet.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// /////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+// ----------------------------------------------------------- Iterator -- == //
+EntitySet::Iterator::Iterator(EntitySet const &set, size_t const index)
+    : set(&set), index(index) {
+    ++set.iterators;
+    skipHoles();
+}
+
+EntitySet::Iterator::Iterator(Iterator const &other)
+    : set(other.set), index(other.index) {
+    ++set->iterators;
+}
+
+EntitySet::Iterator &EntitySet::Iterator::operator=(Iterator const &other) {
+    ++other.set->iterators;
+    --set->iterators;
+    set = other.set;
+    index = other.index;
+    return *this;
+}
+
+EntitySet::Iterator::~Iterator() { --set->iterators; }
+
+EntitySet::Iterator &EntitySet::Iterator::operator++() {
+    ++index;
+    skipHoles();
+    return *this;
+}
+
+size_t EntitySet::Iterator::position() const {
+    // The end is evaluated lazily, so entities inserted during the loop are
+    // visited as well
+    return std::min(index, set->dense.size());
+}
+
+void EntitySet::Iterator::skipHoles() {
+    while (index < set->dense.size() && set->dense[index] == EMPTY_ENTITY) {
+        ++index;
+    }
+}
+
+// ------------------------------------------------- Main functionality -- == //
+bool EntitySet::insert(EntityId const entityId) {
+    if (contains(entityId)) {
+        return false;
+    }
+
+    // While sorted, the last entity which isn't a hole is the largest one
+    if (sorted) {
+        auto last = dense.rbegin();
+        while (last != dense.rend() && *last == EMPTY_ENTITY) {
+            ++last;
+        }
+        if (last != dense.rend() && *last > entityId) {
+            sorted = false;
+        }
+    }
+
+    sparse.set(entityId, static_cast<EntityId>(dense.size()));
+    dense.push_back(entityId);
+    return true;
+}
+
+bool EntitySet::erase(EntityId const entityId) {
+    if (!contains(entityId)) {
+        return false;
+    }
+
+    // Leave a hole, so the loops over the set aren't disturbed
+    dense[sparse.get(entityId)] = EMPTY_ENTITY;
+    sparse.reset(entityId);
+    ++holes;
+    return true;
+}
+
+bool EntitySet::contains(EntityId const entityId) const {
+    return sparse.get(entityId) != EMPTY_ENTITY;
+}
+
+void EntitySet::clear() {
+    dense.clear();
+    sparse.clear();
+    holes = 0;
+    sorted = true;
+}
+
+// ---------------------------------------------------------- Iteration -- == //
+EntitySet::Iterator EntitySet::begin() const {
+    // Compacting moves the entities under the iterators of the outer loops,
+    // so nested loops leave it to the next loop over the whole set
+    if (iterators == 0) {
+        compact();
+    }
+    return Iterator{*this, 0};
+}
+
+EntitySet::Iterator EntitySet::end() const {
+    return Iterator{*this, std::numeric_limits<size_t>::max()};
+}
+
+void EntitySet::compact() const {
+    if (holes == 0 && (sorted || !ordered)) {
+        return;
+    }
+
+    if (holes > 0) {
+        dense.erase(std::remove(dense.begin(), dense.end(), EMPTY_ENTITY),
+                    dense.end());
+        holes = 0;
+    }
+    if (ordered && !sorted) {
+        std::sort(dense.begin(), dense.end());
+        sorted = true;
+    }
+
+    for (size_t index = 0; index < dense.size(); ++index) {
+        sparse.set(dense[index], static_cast<EntityId>(index));
+    }
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
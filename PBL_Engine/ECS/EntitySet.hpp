@@ -0,0 +1,80 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cstddef>
+#include <vector>
+
+#include "EngineAPI.hpp"
+#include "Entity.hpp"
+#include "SparseIndex.hpp"
+#include "Utilities.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Membership set of the entities matched by a system, the identifiers are
+// kept in a dense array with a sparse index, so inserting and erasing is
+// constant time and iterating is a linear scan. Erased entities leave holes
+// behind which are skipped while iterating and compacted on the next
+// iteration, so the set can be safely changed inside a loop over itself.
+// Unless told otherwise the entities are visited in increasing order of
+// their identifiers. Loops nested in a loop over the same set don't compact
+// it and may visit the entities out of order. A set is iterated by one
+// thread at a time
+class ENGINE_API EntitySet {
+  public:
+    // ========================================================= Behaviour == //
+    class ENGINE_API Iterator {
+      public:
+        Iterator(EntitySet const &set, size_t index);
+        Iterator(Iterator const &other);
+        Iterator &operator=(Iterator const &other);
+        ~Iterator();
+
+        Entity operator*() const { return Entity{set->dense[index]}; }
+        Iterator &operator++();
+
+        bool operator==(Iterator const &other) const {
+            return position() == other.position();
+        }
+        bool operator!=(Iterator const &other) const {
+            return !(*this == other);
+        }
+
+      private:
+        size_t position() const;
+        void skipHoles();
+
+        EntitySet const *set;
+        size_t index;
+    };
+
+    // --------------------------------------------- Main functionality -- == //
+    bool insert(EntityId entityId);
+    bool erase(EntityId entityId);
+    bool contains(EntityId entityId) const;
+    void clear();
+
+    size_t size() const { return dense.size() - holes; }
+    bool empty() const { return size() == 0; }
+
+    // Systems which don't depend on the order of their entities can skip
+    // sorting them after the set changes
+    void keepSorted(bool sorted) { ordered = sorted; }
+
+    // ------------------------------------------------------ Iteration -- == //
+    Iterator begin() const;
+    Iterator end() const;
+
+  private:
+    // ========================================================= Behaviour == //
+    void compact() const;
+
+    // ============================================================== Data == //
+    mutable std::vector<EntityId> dense;
+    mutable SparseIndex sparse;
+    mutable size_t holes{0};
+    mutable size_t iterators{0};
+    mutable bool sorted{true};
+    bool ordered{true};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
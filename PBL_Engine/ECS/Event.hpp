@@ -1,7 +1,34 @@
 #pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
 #include "EngineAPI.hpp"
+#include "Events/ForwardDeclarations.hpp"
+#include "Utilities.hpp"
+
+// /////////////////////////////////////////////////////////////// Registrant //
+struct ENGINE_API EventRegistrant {
+    template <typename EventType>
+    static EventId id() {
+        return EMPTY_EVENT;
+    }
+};
 
-// //////////////////////////////////////////////////////////////////// Class //
+// /////////////////////////////////////////////////////////////////// Macros //
 #define ECS_EVENT(T) struct ENGINE_API T
 
+#define ECS_SET_EVENT_ID(T, N)                \
+    template <>                               \
+    inline EventId EventRegistrant::id<T>() { \
+        return (N);                           \
+    }
+
+// ////////////////////////////////////////////////////////////// Identifiers //
+ECS_SET_EVENT_ID(OnButtonClick, 0u)
+ECS_SET_EVENT_ID(OnButtonHover, 1u)
+ECS_SET_EVENT_ID(OnCollisionEnter, 2u)
+ECS_SET_EVENT_ID(OnCollisionExit, 3u)
+ECS_SET_EVENT_ID(OnCollisionStay, 4u)
+ECS_SET_EVENT_ID(OnGameExit, 5u)
+ECS_SET_EVENT_ID(OnGameStateChange, 6u)
+
 // ////////////////////////////////////////////////////////////////////////// //
@@ -1,6 +1,13 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include "EventManager.hpp"
 
+#include <algorithm>
+
+// ////////////////////////////////////////////////////////////////// Globals //
+namespace {
+bool eventManagerExists = false;
+}
+
 // //////////////////////////////////////////////////////////////////// Class //
 // ============================================================= Behaviour == //
 // ---------------------------------------------------------- Singleton -- == //
@@ -9,4 +16,71 @@ EventManager& EventManager::instance() {
     return eventManager;
 }
 
+bool EventManager::exists() { return eventManagerExists; }
+
+EventManager::EventManager() { eventManagerExists = true; }
+
+EventManager::~EventManager() { eventManagerExists = false; }
+
+// ------------------------------------------------- Main functionality -- == //
+void EventManager::unlisten(ListenerId const listenerId) {
+    auto& eventListeners = listeners.at(listenerId.event);
+    auto const listener =
+        std::find_if(eventListeners.begin(), eventListeners.end(),
+                     [&listenerId](auto const& listener) {
+                         return listener.serial == listenerId.serial;
+                     });
+    if (listener == eventListeners.end()) {
+        return;
+    }
+
+    if (sendingDepth > 0) {
+        listener->invoke = nullptr;
+        anyUnlistened = true;
+    } else {
+        eventListeners.erase(listener);
+    }
+}
+
+// -------------------------------------------------------------- Queue -- == //
+void EventManager::flush() {
+    for (auto& eventQueue : queues) {
+        if (eventQueue) {
+            eventQueue->flush(*this);
+        }
+    }
+}
+
+// ------------------------------------------------------------ Helpers -- == //
+void EventManager::dispatch(EventId const eventId, void const* const events,
+                            size_t const count) {
+    auto const& eventListeners = listeners.at(eventId);
+
+    // Listeners may subscribe new ones while handling the event, so the
+    // array is indexed instead of iterated
+    ++sendingDepth;
+    for (size_t i = 0; i < eventListeners.size(); ++i) {
+        auto const listener = eventListeners[i];
+        if (listener.invoke) {
+            listener.invoke(listener.instance, events, count);
+        }
+    }
+    --sendingDepth;
+
+    if (sendingDepth == 0 && anyUnlistened) {
+        removeUnlistened();
+    }
+}
+
+void EventManager::removeUnlistened() {
+    for (auto& eventListeners : listeners) {
+        eventListeners.erase(
+            std::remove_if(
+                eventListeners.begin(), eventListeners.end(),
+                [](auto const& listener) { return !listener.invoke; }),
+            eventListeners.end());
+    }
+    anyUnlistened = false;
+}
+
 // ////////////////////////////////////////////////////////////////////////// //
@@ -1,16 +1,72 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
-#include <any>
-#include <functional>
-#include <list>
-#include <typeindex>
-#include <unordered_map>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <vector>
 
 #include "EngineAPI.hpp"
 #include "Event.hpp"
 #include "Utilities.hpp"
 
+// ///////////////////////////////////////////////////////////////// Listener //
+// Type-erased callback, the instance is passed back to the trampoline which
+// restores the types of both the instance and the events
+template <typename EventType>
+struct EventListener {
+    void* instance;
+    void (*invoke)(void* instance, void const* events, size_t count);
+};
+
+struct ENGINE_API ListenerId {
+    EventId event{EMPTY_EVENT};
+    unsigned int serial{0};
+};
+
+// Listeners take either a single event or a span of them, the latter get all
+// the events flushed from a queue in one call
+template <typename Method>
+struct ListenerTraits;
+
+template <typename Class, typename EventType>
+struct ListenerTraits<void (Class::*)(EventType const&)> {
+    using Event = EventType;
+    static constexpr bool batched = false;
+};
+
+template <typename Class, typename EventType>
+struct ListenerTraits<void (Class::*)(std::span<EventType const>)> {
+    using Event = EventType;
+    static constexpr bool batched = true;
+};
+
+template <typename EventType>
+struct ListenerTraits<void (*)(EventType const&)> {
+    using Event = EventType;
+    static constexpr bool batched = false;
+};
+
+template <typename EventType>
+struct ListenerTraits<void (*)(std::span<EventType const>)> {
+    using Event = EventType;
+    static constexpr bool batched = true;
+};
+
+// //////////////////////////////////////////////////////////////////// Queue //
+class EventManager;
+
+class ENGINE_API IEventQueue {
+  public:
+    // ========================================================= Behaviour == //
+    virtual ~IEventQueue() = default;
+    virtual void flush(EventManager& eventManager) = 0;
+};
+
+template <typename EventType>
+class EventQueue;
+
 // //////////////////////////////////////////////////////////////////// Class //
 class ENGINE_API EventManager {
   public:
@@ -18,6 +74,10 @@ class ENGINE_API EventManager {
     // ------------------------------------------------------ Singleton -- == //
     static EventManager& instance();
 
+    // Scripts living in the components can be destroyed after the manager
+    // when the program exits, they have to check it before unsubscribing
+    static bool exists();
+
     EventManager(EventManager const&) = delete;
     EventManager(EventManager&&) = delete;
     EventManager& operator=(EventManager const&) = delete;
@@ -25,33 +85,156 @@ class ENGINE_API EventManager {
 
     // --------------------------------------------- Main functionality -- == //
     template <typename EventType>
-    void listen(std::function<void(EventType const&)> const& listener) {
-        listeners[std::type_index(typeid(EventType))].push_back(listener);
+    ListenerId listen(EventListener<EventType> const& listener) {
+        auto const eventId = id<EventType>();
+        auto const serial = ++lastSerial;
+
+        listeners.at(eventId).push_back(
+            {.serial = serial,
+             .instance = listener.instance,
+             .invoke = listener.invoke});
+        return {.event = eventId, .serial = serial};
     }
 
+    void unlisten(ListenerId listenerId);
+
+    // Events of queued types are stored until they're flushed, instead of
+    // being sent to the listeners right away
     template <typename EventType>
     void send(EventType const& event) {
-        for (auto const& listener :
-             listeners[std::type_index(typeid(EventType))]) {
-            std::any_cast<std::function<void(EventType const&)>>(listener)(
-                event);
+        auto const eventId = id<EventType>();
+        if (queues[eventId]) {
+            static_cast<EventQueue<EventType>&>(*queues[eventId]).push(event);
+        } else {
+            dispatch(eventId, &event, 1);
         }
     }
 
+    // ---------------------------------------------------------- Queue -- == //
+    template <typename EventType>
+    void queue(bool const queued = true) {
+        auto& eventQueue = queues[id<EventType>()];
+        if (queued && !eventQueue) {
+            eventQueue = std::make_unique<EventQueue<EventType>>();
+        } else if (!queued && eventQueue) {
+            eventQueue->flush(*this);
+            eventQueue.reset();
+        }
+    }
+
+    template <typename EventType>
+    void flush() {
+        if (auto& eventQueue = queues[id<EventType>()]) {
+            eventQueue->flush(*this);
+        }
+    }
+
+    void flush();
+
+    // ------------------------------------------------------ Listeners -- == //
+    template <auto Method, typename Class>
+    static auto method(Class* instance) {
+        using Traits = ListenerTraits<decltype(Method)>;
+        using EventType = typename Traits::Event;
+        return EventListener<EventType>{
+            .instance = instance,
+            .invoke = [](void* instance, void const* events,
+                         size_t const count) {
+                auto const first = static_cast<EventType const*>(events);
+                if constexpr (Traits::batched) {
+                    (static_cast<Class*>(instance)->*Method)({first, count});
+                } else {
+                    for (size_t i = 0; i < count; ++i) {
+                        (static_cast<Class*>(instance)->*Method)(first[i]);
+                    }
+                }
+            }};
+    }
+
+    template <auto Function>
+    static auto function() {
+        using Traits = ListenerTraits<decltype(Function)>;
+        using EventType = typename Traits::Event;
+        return EventListener<EventType>{
+            .instance = nullptr,
+            .invoke = [](void*, void const* events, size_t const count) {
+                auto const first = static_cast<EventType const*>(events);
+                if constexpr (Traits::batched) {
+                    Function({first, count});
+                } else {
+                    for (size_t i = 0; i < count; ++i) {
+                        Function(first[i]);
+                    }
+                }
+            }};
+    }
+
   private:
+    template <typename EventType>
+    friend class EventQueue;
+
     // ========================================================= Behaviour == //
     // ------------------------------------------------------ Singleton -- == //
-    EventManager() = default;
-    ~EventManager() = default;
+    EventManager();
+    ~EventManager();
+
+    // -------------------------------------------------------- Helpers -- == //
+    template <typename EventType>
+    static EventId id() {
+        assert(EventRegistrant::id<EventType>() != EMPTY_EVENT &&
+               "Event type identifier must be set before use!");
+
+        return EventRegistrant::id<EventType>();
+    }
+
+    void dispatch(EventId eventId, void const* events, size_t count);
+    void removeUnlistened();
 
     // ============================================================== Data == //
-    std::unordered_map<std::type_index, std::list<std::any>> listeners;
+    struct Listener {
+        unsigned int serial;
+        void* instance;
+        void (*invoke)(void* instance, void const* events, size_t count);
+    };
+
+    std::array<std::vector<Listener>, MAX_EVENTS> listeners{};
+    std::array<std::unique_ptr<IEventQueue>, MAX_EVENTS> queues{};
+    unsigned int lastSerial{0};
+
+    // Listeners removed while sending are only disabled until it's finished
+    unsigned int sendingDepth{0};
+    bool anyUnlistened{false};
+};
+
+// //////////////////////////////////////////////////////////////////// Queue //
+// Events are appended to one buffer while the other one is being sent, so
+// listeners can queue further events, which wait for the next flush. Both
+// buffers keep their capacity, so queueing stops allocating after a few frames
+template <typename EventType>
+class EventQueue : public IEventQueue {
+  public:
+    // ========================================================= Behaviour == //
+    void push(EventType const& event) { queued.push_back(event); }
+
+    void flush(EventManager& eventManager) override {
+        if (queued.empty() || !sending.empty()) {
+            return;
+        }
+
+        std::swap(queued, sending);
+        eventManager.dispatch(EventManager::id<EventType>(), sending.data(),
+                              sending.size());
+        sending.clear();
+    }
+
+  private:
+    // ============================================================== Data == //
+    std::vector<EventType> queued, sending;
 };
 
 // /////////////////////////////////////////////////////////////////// Macros //
-#define MethodListener(listener) \
-    std::bind(&listener, this, std::placeholders::_1)
+#define MethodListener(listener) EventManager::method<&listener>(this)
 
-#define FunctionListener(listener) std::bind(&listener, std::placeholders::_1)
+#define FunctionListener(listener) EventManager::function<&listener>()
 
 // ////////////////////////////////////////////////////////////////////////// //
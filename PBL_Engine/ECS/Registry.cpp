@@ -1,6 +1,8 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include "Registry.hpp"
 
+#include <algorithm>
+
 #include "Entity.hpp"
 
 // //////////////////////////////////////////////////////////////////// Class //
@@ -13,6 +15,8 @@ Registry& Registry::instance() {
 
 // -------------------------------------------- Delayed entity deletion -- == //
 bool Registry::refresh() {
+    applyCommands();
+
     bool removed = false;
     for (auto const& entity : entitiesToRemove) {
         entityManager.destroy(entity.id);
@@ -24,6 +28,58 @@ bool Registry::refresh() {
     return removed;
 }
 
+// ----------------------------------------------------- Command buffer -- == //
+void Registry::applyCommands() {
+    auto& commands = commandBuffer.commands;
+    std::stable_sort(commands.begin(), commands.end(),
+                     [](auto const& a, auto const& b) {
+                         return a.entityId < b.entityId;
+                     });
+
+    for (auto it = commands.begin(); it != commands.end();) {
+        auto const entityId = it->entityId;
+        auto const previousSignature = entityManager.getSignature(entityId);
+        auto signature = previousSignature;
+
+        // Apply all changes of one entity in the recorded order
+        for (; it != commands.end() && it->entityId == entityId; ++it) {
+            switch (it->type) {
+                case CommandBuffer::Type::Add:
+                    it->apply(componentManager);
+                    signature.set(it->componentId);
+                    break;
+                case CommandBuffer::Type::Remove:
+                    it->apply(componentManager);
+                    signature.reset(it->componentId);
+                    break;
+                case CommandBuffer::Type::Destroy:
+                    destroyEntity(entityId);
+                    break;
+            }
+        }
+
+        if (signature != previousSignature) {
+            entityManager.setSignature(entityId, signature);
+            systemManager.changeEntitySignature(entityId, previousSignature,
+                                                signature);
+        }
+    }
+    commands.clear();
+}
+
+// ------------------------------------------------------------- Access -- == //
+namespace {
+thread_local Signature const* allowedWrites = nullptr;
+}
+
+void Registry::restrictWrites(Signature const* const writes) {
+    allowedWrites = writes;
+}
+
+bool Registry::writable(ComponentId const componentId) {
+    return allowedWrites == nullptr || allowedWrites->test(componentId);
+}
+
 // ------------------------------------------------------------- Entity -- == //
 Entity Registry::createEntity() { return entityManager.create(); }
 
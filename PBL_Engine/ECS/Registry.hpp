@@ -1,9 +1,13 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
+#include <cassert>
 #include <memory>
+#include <span>
+#include <type_traits>
 #include <vector>
 
+#include "CommandBuffer.hpp"
 #include "ComponentManager.hpp"
 #include "EngineAPI.hpp"
 #include "EntityManager.hpp"
@@ -29,10 +33,24 @@ class ENGINE_API Registry {
     // ---------------------------------------- Delayed entity deletion -- == //
     bool refresh();
 
+    // ------------------------------------------------ Command buffer -- == //
+    // Structural changes recorded here are applied by refresh() or earlier,
+    // when the level loader or a system calls applyCommands() once it's done
+    // recording
+    CommandBuffer& commands() { return commandBuffer; }
+    void applyCommands();
+
     // --------------------------------------------------------- Entity -- == //
     Entity createEntity();
     void destroyEntity(Entity const& entity);
 
+    EntityHandle handle(EntityId entityId) const {
+        return entityManager.handle(entityId);
+    }
+    bool valid(EntityHandle handle) const {
+        return entityManager.valid(handle);
+    }
+
     // ------------------------------------------------------ Component -- == //
     template <typename ComponentType>
     void addComponent(EntityId entityId, ComponentType const& component) {
@@ -46,11 +64,75 @@ class ENGINE_API Registry {
         updateEntitySignature<ComponentType>(entityId, false);
     }
 
+    // Adds or removes the tag of many entities at once, the systems
+    // filtering by it are updated once for all of them
+    template <typename TagType>
+    void tag(std::span<EntityId const> entityIds, bool const enabled) {
+        static_assert(std::is_empty_v<TagType>,
+                      "Only tags can be toggled in bulk!");
+
+        auto const tagId = componentManager.id<TagType>();
+        taggedEntities.clear();
+        taggedSignatures.clear();
+        for (auto const entityId : entityIds) {
+            auto signature = entityManager.getSignature(entityId);
+            if (signature.test(tagId) == enabled) {
+                continue;
+            }
+
+            // Systems without filters only notice entities without any
+            // components, these are rare enough to go one by one
+            if (signature.none()) {
+                addComponent<TagType>(entityId, {});
+                continue;
+            }
+
+            if (enabled) {
+                componentManager.add<TagType>(entityId, {});
+            } else {
+                componentManager.remove<TagType>(entityId);
+            }
+            signature.set(tagId, enabled);
+            entityManager.setSignature(entityId, signature);
+
+            taggedEntities.push_back(entityId);
+            taggedSignatures.push_back(signature);
+        }
+
+        systemManager.changeEntitySignatures(tagId, taggedEntities,
+                                             taggedSignatures);
+    }
+
+    // Mutable access marks the component as changed, see eachChanged. Reads
+    // go through peek, the systems run by the scheduler may change only the
+    // components they declared to write
     template <typename ComponentType>
     ComponentType& component(EntityId entityId) {
+        assert(writable(componentManager.id<ComponentType>()) &&
+               "Component type must be declared as written by the system!");
         return componentManager.get<ComponentType>(entityId);
     }
 
+    template <typename ComponentType>
+    ComponentType const& peek(EntityId entityId) {
+        return componentManager.peek<ComponentType>(entityId);
+    }
+
+    template <typename ComponentType>
+    void patch(EntityId entityId) {
+        assert(writable(componentManager.id<ComponentType>()) &&
+               "Component type must be declared as written by the system!");
+        componentManager.patch<ComponentType>(entityId);
+    }
+
+    // Visits the entities whose component was added or accessed mutably
+    // after the given version, returns the version for the next call
+    template <typename ComponentType, typename Function>
+    ChangeVersion eachChanged(ChangeVersion since, Function&& function) {
+        return componentManager.eachChanged<ComponentType>(
+            since, std::forward<Function>(function));
+    }
+
     template <typename ComponentType>
     ComponentId componentId() {
         return componentManager.id<ComponentType>();
@@ -61,6 +143,20 @@ class ENGINE_API Registry {
         return componentManager.has<ComponentType>(entityId);
     }
 
+    // --------------------------------------------------------- Access -- == //
+    // Restricts the mutable access on the calling thread to the given
+    // components until it's called with null, used by the scheduler
+    static void restrictWrites(Signature const* writes);
+    static bool writable(ComponentId componentId);
+
+    // ----------------------------------------------------------- View -- == //
+    // Iterate over every entity owning all given components without going
+    // through the entity handle on each access
+    template <typename... ComponentTypes>
+    auto view() {
+        return componentManager.view<ComponentTypes...>();
+    }
+
     // --------------------------------------------------------- System -- == //
     template <typename SystemType>
     std::shared_ptr<SystemType> system() {
@@ -74,8 +170,12 @@ class ENGINE_API Registry {
 
     // ---------------------------------------------------------- Event -- == //
     template <typename EventType>
-    void listen(std::function<void(EventType const&)> const& listener) {
-        eventManager.listen(listener);
+    ListenerId listen(EventListener<EventType> const& listener) {
+        return eventManager.listen(listener);
+    }
+
+    void unlisten(ListenerId const listenerId) {
+        eventManager.unlisten(listenerId);
     }
 
     template <typename EventType>
@@ -83,6 +183,18 @@ class ENGINE_API Registry {
         eventManager.send(event);
     }
 
+    template <typename EventType>
+    void queue(bool const queued = true) {
+        eventManager.queue<EventType>(queued);
+    }
+
+    template <typename EventType>
+    void flush() {
+        eventManager.flush<EventType>();
+    }
+
+    void flush() { eventManager.flush(); }
+
   private:
     // ========================================================= Behaviour == //
     // ------------------------------------------------------ Singleton -- == //
@@ -92,11 +204,13 @@ class ENGINE_API Registry {
     // -------------------------------------------------------- Helpers -- == //
     template <typename Component>
     void updateEntitySignature(EntityId entityId, bool active) {
-        auto signature = entityManager.getSignature(entityId);
+        auto const previousSignature = entityManager.getSignature(entityId);
+        auto signature = previousSignature;
         signature.set(componentManager.id<Component>(), active);
         entityManager.setSignature(entityId, signature);
 
-        systemManager.changeEntitySignature(entityId, signature);
+        systemManager.changeEntitySignature(entityId, previousSignature,
+                                            signature);
     }
 
     // ============================================================== Data == //
@@ -108,6 +222,13 @@ class ENGINE_API Registry {
 
     // ---------------------------------------- Delayed entity deletion -- == //
     std::vector<Entity> entitiesToRemove;
+
+    // ------------------------------------------------ Command buffer -- == //
+    CommandBuffer commandBuffer;
+
+    // ------------------------------------------------------------ Tag -- == //
+    std::vector<EntityId> taggedEntities;
+    std::vector<Signature> taggedSignatures;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
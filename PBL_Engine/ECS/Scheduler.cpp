@@ -0,0 +1,137 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "System.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+Scheduler::Scheduler(std::vector<std::shared_ptr<System>> const& systems) {
+    for (auto const& system : systems) {
+        nodes.push_back({.system = system,
+                         .dependents = {},
+                         .dependencies = 0,
+                         .waitingFor = 0,
+                         .mainThread = !system->access.declared});
+    }
+
+    // Every system depends on the earlier ones it conflicts with
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (nodes[j].system->access.conflicts(nodes[i].system->access)) {
+                nodes[j].dependents.push_back(i);
+                ++nodes[i].dependencies;
+            }
+        }
+    }
+
+    parallel = std::count_if(nodes.begin(), nodes.end(), [](auto const& node) {
+                   return !node.mainThread;
+               }) > 1;
+}
+
+void Scheduler::update(float const deltaTime) {
+    frameDeltaTime = deltaTime;
+    if (sequential || !parallel) {
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            run(node);
+        }
+        return;
+    }
+
+    std::exception_ptr failure;
+    std::unique_lock lock(mutex);
+    remaining = nodes.size();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].waitingFor = nodes[i].dependencies;
+        if (nodes[i].dependencies == 0) {
+            start(i);
+        }
+    }
+
+    // The calling thread updates the systems bound to it and helps the job
+    // system with the rest while waiting for the frame to finish
+    while (remaining > 0) {
+        if (readyOnMainThread.empty()) {
+            lock.unlock();
+            auto const helped = JobSystem::instance().help();
+            lock.lock();
+
+            if (!helped) {
+                readyChanged.wait(lock, [this] {
+                    return !readyOnMainThread.empty() || remaining == 0;
+                });
+            }
+            continue;
+        }
+
+        auto const node = readyOnMainThread.front();
+        readyOnMainThread.pop_front();
+
+        lock.unlock();
+        try {
+            run(node);
+        } catch (...) {
+            failure = failure ? failure : std::current_exception();
+        }
+        finish(node);
+        lock.lock();
+    }
+
+    // The last jobs may be still returning after finishing their systems
+    lock.unlock();
+    JobSystem::instance().wait(jobs);
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void Scheduler::start(size_t const node) {
+    if (nodes[node].mainThread) {
+        readyOnMainThread.push_back(node);
+        return;
+    }
+
+    // A failed system still lets the frame finish, the job system rethrows
+    // its exception from the wait at the end
+    JobSystem::instance().run(jobs, [this, node] {
+        try {
+            run(node);
+        } catch (...) {
+            finish(node);
+            throw;
+        }
+        finish(node);
+    });
+}
+
+void Scheduler::run(size_t const node) {
+    // Changing a component the system only reads would race with the other
+    // readers, the registry checks it in debug builds
+    auto const& access = nodes[node].system->access;
+    Registry::restrictWrites(access.declared ? &access.writes : nullptr);
+    try {
+        nodes[node].system->update(frameDeltaTime);
+    } catch (...) {
+        Registry::restrictWrites(nullptr);
+        throw;
+    }
+    Registry::restrictWrites(nullptr);
+}
+
+void Scheduler::finish(size_t const node) {
+    {
+        std::scoped_lock lock(mutex);
+        for (auto const dependent : nodes[node].dependents) {
+            if (--nodes[dependent].waitingFor == 0) {
+                start(dependent);
+            }
+        }
+        --remaining;
+    }
+    readyChanged.notify_all();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,65 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "EngineAPI.hpp"
+#include "JobSystem.hpp"
+
+// ///////////////////////////////////////////////////// Forward declarations //
+struct ENGINE_API System;
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Runs the systems as if they were updated one after another in the given
+// order, but the ones with declared, non-conflicting component access are
+// updated at the same time by the job system. Each system waits only for
+// the earlier systems it conflicts with. Systems which didn't declare their
+// access are always updated alone on the calling thread
+class ENGINE_API Scheduler {
+  public:
+    // ========================================================= Behaviour == //
+    Scheduler(std::vector<std::shared_ptr<System>> const& systems);
+
+    Scheduler(Scheduler const&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(Scheduler const&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+
+    void update(float deltaTime);
+
+    // Updates the systems strictly in order on the calling thread, for
+    // debugging the problems caused by undeclared access
+    void deterministic(bool enabled) { sequential = enabled; }
+
+  private:
+    // ========================================================= Behaviour == //
+    void start(size_t node);
+    void run(size_t node);
+    void finish(size_t node);
+
+    // ============================================================== Data == //
+    struct Node {
+        std::shared_ptr<System> system;
+        std::vector<size_t> dependents;
+        size_t dependencies{0};
+        size_t waitingFor{0};
+        bool mainThread;
+    };
+
+    std::vector<Node> nodes;
+    bool parallel{false};
+
+    std::mutex mutex;
+    std::condition_variable readyChanged;
+    std::deque<size_t> readyOnMainThread;
+    JobGroup jobs;
+    size_t remaining{0};
+    float frameDeltaTime{0.0f};
+    bool sequential{false};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,71 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "EngineAPI.hpp"
+#include "Utilities.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Maps entity identifiers to dense indices, the mapping is split into pages
+// allocated only when an entity from their range is stored, so the memory
+// follows the identifiers actually in use instead of MAX_ENTITIES
+class ENGINE_API SparseIndex {
+  public:
+    // ========================================================= Behaviour == //
+    SparseIndex() = default;
+
+    SparseIndex(SparseIndex const &) = delete;
+    SparseIndex(SparseIndex &&) = default;
+    SparseIndex &operator=(SparseIndex const &) = delete;
+    SparseIndex &operator=(SparseIndex &&) = default;
+
+    // Returns EMPTY_ENTITY for identifiers without index
+    EntityId get(EntityId const entityId) const {
+        auto const page = entityId / PAGE_SIZE;
+        if (page >= pages.size() || !pages[page]) {
+            return EMPTY_ENTITY;
+        }
+        return (*pages[page])[entityId % PAGE_SIZE];
+    }
+
+    void set(EntityId const entityId, EntityId const index) {
+        auto const page = entityId / PAGE_SIZE;
+        if (page >= pages.size()) {
+            pages.resize(page + 1u);
+        }
+        if (!pages[page]) {
+            pages[page] = std::make_unique<Page>();
+            pages[page]->fill(EMPTY_ENTITY);
+        }
+        (*pages[page])[entityId % PAGE_SIZE] = index;
+    }
+
+    void reset(EntityId const entityId) {
+        if (get(entityId) != EMPTY_ENTITY) {
+            (*pages[entityId / PAGE_SIZE])[entityId % PAGE_SIZE] =
+                EMPTY_ENTITY;
+        }
+    }
+
+    void clear() { pages.clear(); }
+
+    size_t residentBytes() const {
+        size_t bytes = pages.capacity() * sizeof(std::unique_ptr<Page>);
+        for (auto const &page : pages) {
+            bytes += page ? sizeof(Page) : 0u;
+        }
+        return bytes;
+    }
+
+  private:
+    // ============================================================== Data == //
+    static constexpr EntityId PAGE_SIZE = 4096u;
+    using Page = std::array<EntityId, PAGE_SIZE>;
+
+    std::vector<std::unique_ptr<Page>> pages;
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -1,13 +1,25 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
-#include <set>
-
 #include "EngineAPI.hpp"
 #include "Entity.hpp"
+#include "EntitySet.hpp"
 #include "Registry.hpp"
 #include "SystemManager.hpp"
 
+// /////////////////////////////////////////////////////////////////// Access //
+struct ENGINE_API SystemAccess {
+    // ========================================================= Behaviour == //
+    bool conflicts(SystemAccess const& other) const {
+        return !declared || !other.declared || (writes & other.writes).any() ||
+               (writes & other.reads).any() || (reads & other.writes).any();
+    }
+
+    // ============================================================== Data == //
+    Signature reads, writes;
+    bool declared{false};
+};
+
 // /////////////////////////////////////////////////////////////// Registrant //
 template <typename SystemType>
 class ENGINE_API SystemRegistrant {
@@ -28,6 +40,28 @@ class ENGINE_API SystemWrapper {
         registry.filter<SystemType, ComponentType>(active);
         return *this;
     }
+
+    // Systems declaring their access can be run alongside the others which
+    // don't touch the same components, the rest runs alone on the main thread
+    template <typename ComponentType>
+    SystemWrapper& read() {
+        concurrent().reads.set(ComponentRegistrant::id<ComponentType>());
+        return *this;
+    }
+
+    template <typename ComponentType>
+    SystemWrapper& write() {
+        concurrent().writes.set(ComponentRegistrant::id<ComponentType>());
+        return *this;
+    }
+
+    // For systems which don't access any components at all
+    SystemAccess& concurrent() {
+        auto& access = static_cast<SystemType&>(*this).access;
+        access.declared = true;
+        return access;
+    }
+
     static inline Registry& registry = Registry::instance();
 };
 
@@ -43,7 +77,8 @@ struct ENGINE_API System {
     virtual void release() = 0;
 
     // ============================================================== Data == //
-    std::set<Entity> entities;
+    EntitySet entities;
+    SystemAccess access;
 };
 
 // /////////////////////////////////////////////////////////////////// Macros //
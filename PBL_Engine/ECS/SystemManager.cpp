@@ -16,26 +16,91 @@ SystemManager& SystemManager::instance() {
 
 void SystemManager::destroyEntity(EntityId entityId) {
     for (auto const& [typeIndex, system] : systems) {
-        if (auto entity = Entity{entityId};
-            system->entities.find(entity) != system->entities.end()) {
-            system->entities.erase(entity);
-        }
+        system->entities.erase(entityId);
     }
 }
 
 void SystemManager::changeEntitySignature(EntityId entityId,
+                                          Signature const& previousSignature,
                                           Signature const& entitySignature) {
-    for (auto const& [typeIndex, system] : systems) {
-        auto const& systemSignature = signatures[typeIndex];
-        // assert(systemSignature.any() &&
-        //       "Each system must have a non-empty signature!");
+    if (subscriptionsOutdated) {
+        updateSubscriptions();
+    }
 
+    auto const refresh = [&](Subscription const& subscription) {
+        auto const& systemSignature = subscription.signature;
         if ((entitySignature & systemSignature) == systemSignature) {
-            system->entities.insert(Entity(entityId));
+            subscription.system->entities.insert(entityId);
         } else {
-            system->entities.erase(Entity(entityId));
+            subscription.system->entities.erase(entityId);
+        }
+    };
+
+    // Systems without any filters match every entity from its first
+    // component onwards
+    if (previousSignature.none()) {
+        for (auto const index : unfilteredSubscriptions) {
+            refresh(subscriptions[index]);
         }
     }
+
+    auto const changed = previousSignature ^ entitySignature;
+    for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (changed.test(id)) {
+            for (auto const index : subscriptionsByComponent[id]) {
+                refresh(subscriptions[index]);
+            }
+        }
+    }
+}
+
+void SystemManager::changeEntitySignatures(
+    ComponentId const componentId, std::span<EntityId const> entityIds,
+    std::span<Signature const> entitySignatures) {
+    assert(entityIds.size() == entitySignatures.size() &&
+           "Every entity must have its signature!");
+
+    if (subscriptionsOutdated) {
+        updateSubscriptions();
+    }
+
+    // Every system filtering by the component is updated for all entities
+    // in one go
+    for (auto const index : subscriptionsByComponent[componentId]) {
+        auto const& [system, systemSignature] = subscriptions[index];
+        for (size_t i = 0; i < entityIds.size(); ++i) {
+            if ((entitySignatures[i] & systemSignature) == systemSignature) {
+                system->entities.insert(entityIds[i]);
+            } else {
+                system->entities.erase(entityIds[i]);
+            }
+        }
+    }
+}
+
+void SystemManager::updateSubscriptions() {
+    subscriptions.clear();
+    unfilteredSubscriptions.clear();
+    for (auto& bucket : subscriptionsByComponent) {
+        bucket.clear();
+    }
+
+    for (auto const& [typeIndex, system] : systems) {
+        auto const index = subscriptions.size();
+        auto const& signature = signatures[typeIndex];
+        subscriptions.push_back({system.get(), signature});
+
+        if (signature.none()) {
+            unfilteredSubscriptions.push_back(index);
+        }
+        for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+            if (signature.test(id)) {
+                subscriptionsByComponent[id].push_back(index);
+            }
+        }
+    }
+
+    subscriptionsOutdated = false;
 }
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -1,11 +1,14 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
+#include <array>
 #include <cassert>
 #include <memory>
+#include <span>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 #include "ComponentManager.hpp"
 #include "EngineAPI.hpp"
@@ -36,6 +39,8 @@ class ENGINE_API SystemManager {
         systems.insert({typeIndex, std::make_shared<SystemType>()});
         signatures.insert({typeIndex, Signature{}});
 
+        subscriptionsOutdated = true;
+
         systems[typeIndex]->filters();
     }
 
@@ -56,12 +61,19 @@ class ENGINE_API SystemManager {
 
         signatures[typeIndex].set(
             ComponentManager::instance().id<ComponentType>(), active);
+        subscriptionsOutdated = true;
     }
 
     void destroyEntity(EntityId entityId);
     void changeEntitySignature(EntityId entityId,
+                               Signature const& previousSignature,
                                Signature const& entitySignature);
 
+    // For many entities which changed only the given component
+    void changeEntitySignatures(ComponentId componentId,
+                                std::span<EntityId const> entityIds,
+                                std::span<Signature const> entitySignatures);
+
   private:
     // ========================================================= Behaviour == //
     SystemManager() = default;
@@ -71,9 +83,23 @@ class ENGINE_API SystemManager {
         return systems.find(typeIndex) != systems.end();
     }
 
+    void updateSubscriptions();
+
     // ============================================================== Data == //
     std::unordered_map<std::type_index, std::shared_ptr<System>> systems{};
     std::unordered_map<std::type_index, Signature> signatures{};
+
+    // Systems bucketed by the components in their signatures, so changing
+    // one component only touches the systems filtering by it
+    struct Subscription {
+        System* system;
+        Signature signature;
+    };
+
+    std::vector<Subscription> subscriptions{};
+    std::array<std::vector<size_t>, MAX_COMPONENTS> subscriptionsByComponent{};
+    std::vector<size_t> unfilteredSubscriptions{};
+    bool subscriptionsOutdated{true};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -5,7 +5,12 @@
 
 // ///////////////////////////////////////////////////// Usings and constants //
 using EntityId = unsigned int;
-constexpr EntityId MAX_ENTITIES = 16384u;
+constexpr unsigned int ENTITY_INDEX_BITS = 20u;
+constexpr unsigned int ENTITY_GENERATION_BITS = 32u - ENTITY_INDEX_BITS;
+constexpr EntityId ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1u;
+// The last index is never given to an entity, it's the one of null handles
+constexpr EntityId NULL_ENTITY = ENTITY_INDEX_MASK;
+constexpr EntityId MAX_ENTITIES = NULL_ENTITY;
 constexpr EntityId EMPTY_ENTITY = MAX_ENTITIES + 1u;
 
 using ComponentId = unsigned int;
@@ -13,6 +18,11 @@ constexpr ComponentId MAX_COMPONENTS = 32u;
 constexpr ComponentId EMPTY_COMPONENT = MAX_COMPONENTS + 1u;
 
 using Signature = std::bitset<MAX_COMPONENTS>;
+using ChangeVersion = unsigned int;
+
+using EventId = unsigned int;
+constexpr EventId MAX_EVENTS = 32u;
+constexpr EventId EMPTY_EVENT = MAX_EVENTS + 1u;
 
 // ////////////////////////////////////////////////////////////////////////// //
 
@@ -0,0 +1,60 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <tuple>
+#include <utility>
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Range over all entities owning every requested component type, the cursor
+// is provided by the component storage and yields tuples of the entity's
+// identifier followed by references to its components, e.g.
+//
+//     for (auto [id, transform, collider] :
+//          registry.view<Transform, BoxCollider, Active>()) { ... }
+//
+// Adding or removing the viewed component types while iterating invalidates
+// the view
+template <typename Cursor>
+class View {
+  public:
+    // ========================================================= Behaviour == //
+    struct Sentinel {};
+
+    class Iterator {
+      public:
+        explicit Iterator(Cursor const &cursor) : cursor(cursor) {}
+
+        auto operator*() const { return cursor.current(); }
+
+        Iterator &operator++() {
+            cursor.advance();
+            return *this;
+        }
+
+        bool operator!=(Sentinel) const { return !cursor.done(); }
+        bool operator==(Sentinel) const { return cursor.done(); }
+
+      private:
+        Cursor cursor;
+    };
+
+    explicit View(Cursor const &cursor) : cursor(cursor) {}
+
+    Iterator begin() const { return Iterator{cursor}; }
+    Sentinel end() const { return {}; }
+
+    // Call the function with the identifier and the components of every
+    // entity in the view
+    template <typename Function>
+    void each(Function &&function) const {
+        for (auto it = begin(); it != end(); ++it) {
+            std::apply(function, *it);
+        }
+    }
+
+  private:
+    // ============================================================== Data == //
+    Cursor cursor;
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
+#include "IsDebug.hpp"
 #include "Systems/Systems.hpp"
 #include "Window.h"
 
@@ -30,15 +32,16 @@ Engine::Engine()
                    registry.system<SoundSystem>(),
                    registry.system<PropertySystem>(),
                    registry.system<PhysicsSystem>()},
-      updateSystems{
-          registry.system<WindowSystem>(),
-          registry.system<SceneSystem>(),
-          registry.system<SoundSystem>(),
-          registry.system<BehaviourSystem>(),
-          registry.system<PhysicsSystem>(),
+      updateSystems{registry.system<WindowSystem>(),
+                    registry.system<SceneSystem>(),
+                    registry.system<SoundSystem>(),
+                    registry.system<BehaviourSystem>()},
+      fixedUpdateSystems{registry.system<PhysicsSystem>(),
+                         registry.system<GraphSystem>(),
+                         registry.system<CheckCollisionsSystem>(),
+                         registry.system<ColliderSystem>()},
+      lateUpdateSystems{
           registry.system<GraphSystem>(),
-          registry.system<CheckCollisionsSystem>(),
-          registry.system<ColliderSystem>(),
           registry.system<PropertySystem>(),
           registry.system<AnimatorSystem>(),
           registry.system<LightSystem>(),
@@ -86,23 +89,58 @@ ENGINE_API int Engine::run() {
         system->setup();
     }
 
+    // Systems declare their component access while registering, so the
+    // dependencies between them are known by now
+    updateScheduler = std::make_unique<Scheduler>(updateSystems);
+    fixedUpdateScheduler = std::make_unique<Scheduler>(fixedUpdateSystems);
+    lateUpdateScheduler = std::make_unique<Scheduler>(lateUpdateSystems);
+
+    if constexpr (IS_DEBUG) {
+        for (auto const &[name, count, residentBytes] :
+             ComponentManager::instance().memoryReport()) {
+            OutputDebugStringA((std::string(name) + ": " +
+                                std::to_string(count) + " components, " +
+                                std::to_string(residentBytes) + " bytes\n")
+                                   .c_str());
+        }
+    }
+
     registry.listen<OnGameExit>(MethodListener(Engine::onGameExit));
 
     timer.Mark();
 
     while (runGameLoop) {
-        if (registry.refresh()) {
-            registry.system<GraphSystem>()->setup();
-        }
+        registry.refresh();
 
         if ((exitCode = Window::ProcessMessages())) {
             break;
         }
 
-        auto const &deltaTime = std::clamp(timer.Mark(), 0.0f, 1.0f / 30.0f);
-        for (auto &system : updateSystems) {
-            system->update(deltaTime);
+        auto const frameTime = std::max(timer.Mark(), 0.0f);
+        auto const deltaTime = std::min(frameTime, 1.0f / 30.0f);
+
+        // The scripts react to the input first, then the simulation catches
+        // up with the frame in fixed steps, so it behaves the same at any
+        // frame rate
+        updateScheduler->update(deltaTime);
+
+        auto const graphSystem = registry.system<GraphSystem>();
+        auto const steps = fixedTimestep.advance(frameTime);
+        for (unsigned int step = 0; step < steps; ++step) {
+            graphSystem->beginStep();
+            fixedUpdateScheduler->update(fixedTimestep.step());
+        }
+
+        // Transforms are rendered between the last two steps, the colliders'
+        // corrections from the last one are included too. The ones the
+        // scripts moved this frame are rendered as they are
+        if (steps > 0) {
+            graphSystem->refresh();
         }
+        graphSystem->interpolate(fixedTimestep.fraction());
+
+        lateUpdateScheduler->update(deltaTime);
+        registry.flush();
     }
 
     for (auto &system : releaseSystems) {
@@ -111,6 +149,14 @@ ENGINE_API int Engine::run() {
     return *exitCode;
 }
 
+void Engine::setFixedRate(float const stepsPerSecond) {
+    fixedTimestep.rate(stepsPerSecond);
+}
+
+void Engine::setMaxFixedSteps(unsigned int const steps) {
+    fixedTimestep.maxSteps(steps);
+}
+
 void Engine::onGameExit(OnGameExit const &event) { runGameLoop = false; }
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -1,11 +1,14 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
+#include <memory>
 #include <vector>
 
 #include "ECS/Registry.hpp"
+#include "ECS/Scheduler.hpp"
 #include "ECS/System.hpp"
 #include "EngineAPI.hpp"
+#include "FixedTimestep.hpp"
 #include "Events/OnGameExit.hpp"
 #include "Timer.h"
 #include "Window.h"
@@ -17,13 +20,21 @@ class Engine {
     Engine();
     ENGINE_API int run();
 
+    // Physics and collisions are simulated at a fixed rate, with at most the
+    // given number of steps per frame, slower frames drop the rest of time
+    ENGINE_API void setFixedRate(float stepsPerSecond);
+    ENGINE_API void setMaxFixedSteps(unsigned int steps);
+
     void onGameExit(OnGameExit const &event);
 
   private:
     // ============================================================== Data == //
     Registry &registry;
     std::vector<std::shared_ptr<System>> setupSystems, updateSystems,
-        releaseSystems;
+        fixedUpdateSystems, lateUpdateSystems, releaseSystems;
+    std::unique_ptr<Scheduler> updateScheduler, fixedUpdateScheduler,
+        lateUpdateScheduler;
+    FixedTimestep fixedTimestep;
 
     Timer timer;
     bool runGameLoop = true;
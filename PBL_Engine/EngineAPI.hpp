@@ -1,7 +1,11 @@
 #pragma once
 
 // ////////////////////////////////////////////////////////////////// DLL API //
-#ifdef ENGINE_EXPORTS
+// The tests link the engine's sources statically, also on the platforms
+// without DLLs
+#if defined(ENGINE_STATIC) || !defined(_WIN32)
+#define ENGINE_API
+#elif defined(ENGINE_EXPORTS)
 #define ENGINE_API __declspec(dllexport)
 #else
 #define ENGINE_API __declspec(dllimport)
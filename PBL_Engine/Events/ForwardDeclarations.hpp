@@ -0,0 +1,12 @@
+#pragma once
+
+// /////////////////////////////////////// Forward declarations of all events //
+struct OnButtonClick;
+struct OnButtonHover;
+struct OnCollisionEnter;
+struct OnCollisionExit;
+struct OnCollisionStay;
+struct OnGameExit;
+struct OnGameStateChange;
+
+// ////////////////////////////////////////////////////////////////////////// //
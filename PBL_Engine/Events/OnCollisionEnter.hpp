@@ -5,6 +5,7 @@
 #include "ECS/Entity.hpp"
 #include "ECS/Event.hpp"
 
+// Sent once when the boxes start overlapping
 ECS_EVENT(OnCollisionEnter) {
     Entity a, b;
     DirectX::XMFLOAT3 minSeparatingVector;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "ECS/Entity.hpp"
+#include "ECS/Event.hpp"
+
+// Sent once the boxes stop overlapping, or one of them is gone
+ECS_EVENT(OnCollisionExit) {
+    Entity a, b;
+    float duration;
+};
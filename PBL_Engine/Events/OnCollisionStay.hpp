@@ -0,0 +1,13 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include "ECS/Entity.hpp"
+#include "ECS/Event.hpp"
+
+// Sent every frame after the first one while the boxes keep overlapping
+ECS_EVENT(OnCollisionStay) {
+    Entity a, b;
+    DirectX::XMFLOAT3 minSeparatingVector;
+    float duration;
+};
@@ -0,0 +1,30 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "FixedTimestep.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+void FixedTimestep::rate(float const stepsPerSecond) {
+    assert(stepsPerSecond > 0.0f && "Steps have to take some time");
+    stepTime = 1.0f / stepsPerSecond;
+}
+
+void FixedTimestep::maxSteps(unsigned int const steps) { stepLimit = steps; }
+
+unsigned int FixedTimestep::advance(float const frameTime) {
+    accumulator += std::max(frameTime, 0.0f);
+
+    unsigned int steps = 0;
+    for (; accumulator >= stepTime && steps < stepLimit; ++steps) {
+        accumulator -= stepTime;
+    }
+    if (steps == stepLimit) {
+        accumulator = std::fmod(accumulator, stepTime);
+    }
+    return steps;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
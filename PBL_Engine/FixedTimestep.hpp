@@ -0,0 +1,32 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "EngineAPI.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Splits the real time of the frames into steps of a fixed length, so what's
+// simulated in them behaves the same at any frame rate. The time which
+// doesn't fill a whole step is carried over to the next frame
+class ENGINE_API FixedTimestep {
+  public:
+    // ========================================================= Behaviour == //
+    void rate(float stepsPerSecond);
+    // Slower frames drop the time left over after the given number of steps
+    void maxSteps(unsigned int steps);
+
+    // Number of steps to take for a frame of the given length
+    unsigned int advance(float frameTime);
+
+    float step() const { return stepTime; }
+    // Part of a step left over after the last one, for blending the poses
+    // from before and after it
+    float fraction() const { return accumulator / stepTime; }
+
+  private:
+    // ============================================================== Data == //
+    float stepTime{1.0f / 60.0f};
+    unsigned int stepLimit{4u};
+    float accumulator{0.0f};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
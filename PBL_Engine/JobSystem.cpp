@@ -0,0 +1,165 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "JobSystem.hpp"
+
+#include <utility>
+
+// ////////////////////////////////////////////////////////////////// Globals //
+namespace {
+// Index of the worker running on this thread, the other threads don't have
+// their own queues
+constexpr size_t NO_WORKER = static_cast<size_t>(-1);
+thread_local size_t threadWorker = NO_WORKER;
+}  // namespace
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+// ---------------------------------------------------------- Singleton -- == //
+JobSystem& JobSystem::instance() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::JobSystem() {
+    auto const numberOfWorkers =
+        std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    for (size_t i = 0; i < numberOfWorkers; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    activeWorkers = numberOfWorkers;
+    for (size_t i = 0; i < numberOfWorkers; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::work, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::scoped_lock lock(sleepMutex);
+        stopping = true;
+    }
+    jobQueued.notify_all();
+
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+// ------------------------------------------------- Main functionality -- == //
+void JobSystem::run(JobGroup& group, std::function<void()> job) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Workers push to their own queue, the other threads spread the jobs.
+    // Without active workers the queue of the first one waits for the
+    // calling thread
+    auto const active = std::max<size_t>(activeWorkers, 1);
+    auto const worker = threadWorker != NO_WORKER
+                            ? threadWorker
+                            : nextWorker.fetch_add(1) % active;
+    {
+        std::scoped_lock lock(workers[worker]->mutex);
+        workers[worker]->jobs.push_back({std::move(job), &group});
+    }
+
+    {
+        std::scoped_lock lock(sleepMutex);
+        ++queuedJobs;
+    }
+    jobQueued.notify_one();
+}
+
+void JobSystem::wait(JobGroup& group) {
+    while (!group.done()) {
+        if (!runQueuedJob(threadWorker)) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.exception) {
+        std::rethrow_exception(std::exchange(group.exception, nullptr));
+    }
+}
+
+bool JobSystem::help() { return runQueuedJob(threadWorker); }
+
+void JobSystem::limit(size_t const threads) {
+    {
+        std::scoped_lock lock(sleepMutex);
+        activeWorkers = threads == 0
+                            ? workers.size()
+                            : std::min(threads - 1, workers.size());
+    }
+    jobQueued.notify_all();
+}
+
+// ------------------------------------------------------------ Helpers -- == //
+void JobSystem::work(size_t const worker) {
+    threadWorker = worker;
+
+    while (true) {
+        {
+            std::unique_lock lock(sleepMutex);
+            jobQueued.wait(lock, [this, worker] {
+                return stopping || (queuedJobs > 0 && worker < activeWorkers);
+            });
+            if (stopping) {
+                return;
+            }
+        }
+
+        runQueuedJob(worker);
+    }
+}
+
+bool JobSystem::runQueuedJob(size_t const worker) {
+    Job job;
+    if (!takeJob(worker, job)) {
+        return false;
+    }
+
+    {
+        std::scoped_lock lock(sleepMutex);
+        --queuedJobs;
+    }
+
+    // The group has to be finished even when the job fails, or its wait
+    // would never return
+    try {
+        job.function();
+    } catch (...) {
+        std::scoped_lock lock(job.group->exceptionMutex);
+        if (!job.group->exception) {
+            job.group->exception = std::current_exception();
+        }
+    }
+    job.group->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::takeJob(size_t const worker, Job& job) {
+    // The newest job from the own queue is the most likely to be in cache
+    if (worker != NO_WORKER) {
+        auto& own = *workers[worker];
+        std::scoped_lock lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+
+    // The oldest jobs of the others are stolen, as they are usually the
+    // biggest ones left
+    auto const first = worker != NO_WORKER ? worker + 1 : 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        auto& victim = *workers[(first + i) % workers.size()];
+        std::scoped_lock lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,154 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "EngineAPI.hpp"
+
+// //////////////////////////////////////////////////////////////////// Group //
+// Counts the unfinished jobs started with it, so they can be waited for.
+// The first exception thrown by its jobs is kept until the wait rethrows it
+class ENGINE_API JobGroup {
+  public:
+    // ========================================================= Behaviour == //
+    JobGroup() = default;
+    JobGroup(JobGroup const&) = delete;
+    JobGroup& operator=(JobGroup const&) = delete;
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+
+    // ============================================================== Data == //
+    std::atomic<size_t> pending{0};
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+};
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Pool of worker threads created once for the whole engine. Each worker has
+// its own queue of jobs, takes the newest ones from it and steals the oldest
+// ones from the others when it runs out. Threads waiting for a group run the
+// queued jobs instead of blocking, so jobs can start and wait for other jobs
+class ENGINE_API JobSystem {
+  public:
+    // ========================================================= Behaviour == //
+    // ------------------------------------------------------ Singleton -- == //
+    static JobSystem& instance();
+
+    JobSystem(JobSystem const&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem const&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    // --------------------------------------------- Main functionality -- == //
+    // Jobs are meant for computations, blocking ones like reading files
+    // belong to threads of their own, as any waiting thread may pick them up
+    void run(JobGroup& group, std::function<void()> job);
+
+    // Rethrows the first exception thrown by the jobs of the group, after
+    // all of them finished
+    void wait(JobGroup& group);
+
+    // Runs one of the queued jobs on the calling thread, if there are any
+    bool help();
+
+    // Number of threads running the jobs, including the waiting one
+    size_t concurrency() const {
+        return activeWorkers.load(std::memory_order_relaxed) + 1;
+    }
+
+    // Leaves only the given number of threads running the jobs, including
+    // the waiting one, to measure how the work scales. Zero uses all
+    void limit(size_t threads);
+
+    // Calls the function for every index in [0, count), split into jobs of
+    // at least the given number of indices
+    template <typename Function>
+    void parallelFor(size_t const count, Function&& function,
+                     size_t const grain = 64) {
+        auto const chunk =
+            std::max(grain, (count + concurrency() * 4 - 1) /
+                                (concurrency() * 4));
+        if (count <= chunk) {
+            for (size_t i = 0; i < count; ++i) {
+                function(i);
+            }
+            return;
+        }
+
+        JobGroup group;
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            auto const end = std::min(begin + chunk, count);
+            run(group, [&function, begin, end] {
+                for (size_t i = begin; i < end; ++i) {
+                    function(i);
+                }
+            });
+        }
+        wait(group);
+    }
+
+    // Calls the function with the identifier and the components of every
+    // entity in the view, like View::each does
+    template <typename ViewType, typename Function>
+    void parallelEach(ViewType const& view, Function&& function,
+                     size_t const grain = 64) {
+        std::vector<decltype(*view.begin())> elements;
+        for (auto it = view.begin(); it != view.end(); ++it) {
+            elements.push_back(*it);
+        }
+
+        parallelFor(
+            elements.size(),
+            [&elements, &function](size_t const i) {
+                std::apply(function, elements[i]);
+            },
+            grain);
+    }
+
+  private:
+    // ========================================================= Behaviour == //
+    // ------------------------------------------------------ Singleton -- == //
+    JobSystem();
+    ~JobSystem();
+
+    // -------------------------------------------------------- Helpers -- == //
+    struct Job {
+        std::function<void()> function;
+        JobGroup* group;
+    };
+
+    void work(size_t worker);
+    bool runQueuedJob(size_t worker);
+    bool takeJob(size_t worker, Job& job);
+
+    // ============================================================== Data == //
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> activeWorkers{0};
+    std::atomic<size_t> queuedJobs{0};
+    std::atomic<size_t> nextWorker{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable jobQueued;
+    bool stopping{false};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
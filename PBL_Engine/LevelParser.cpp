@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "BroadPhase.hpp"
 #include "Components/Components.hpp"
 #include "ECS/ECS.hpp"
 #include "Mesh.h"
@@ -33,6 +34,28 @@ std::unordered_map<FileGuid, std::set<FileId>> prefabFileIds;
 
 auto &registry = Registry::instance();
 
+// Layers named in Unity's tag manager which the colliders may be on
+constexpr unsigned int UI_LAYER = 5u;
+
+// Layers which never collide with each other. Unity's collision matrix stays
+// in the project settings, which aren't shipped with the assets, so they're
+// listed here instead. The interface isn't part of the level
+LayerMatrix const &layerMatrix() {
+    static LayerMatrix const matrix = [] {
+        LayerMatrix matrix;
+        for (unsigned int layer = 0; layer < LayerMatrix::LAYERS; ++layer) {
+            matrix.ignore(UI_LAYER, layer);
+        }
+        return matrix;
+    }();
+    return matrix;
+}
+
+void setLayer(BoxCollider &boxCollider, unsigned int const layer) {
+    boxCollider.layers = 1u << layer;
+    boxCollider.mask = layerMatrix().mask(layer);
+}
+
 #define yamlLoop(iterator, node)                         \
     for (YAML::const_iterator iterator = (node).begin(); \
          iterator != (node).end(); ++iterator)
@@ -84,7 +107,8 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                    nodeGameObject["m_IsActive"] &&
                    "Every property inside GameObject component must be valid!");
 
-            entity.add<Properties>(
+            registry.commands().add<Properties>(
+                entity.id,
                 {.name = nodeGameObject["m_Name"].as<std::string>(),
                  .tag = nodeGameObject["m_TagString"].as<std::string>(),
                  .active = static_cast<bool>(
@@ -124,13 +148,12 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
             {
                 auto &helper = nodeTransform["m_GameObject"];
                 auto gameObjectFileId = helper["fileID"].Scalar();
-                Entity(entityIds[gameObjectFileId]).add<Transform>({});
                 entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 entityIdsWithTransform.insert(
                     {fileId, entityIds[gameObjectFileId]});
             }
 
-            auto &transform = Entity(entityIds[fileId]).get<Transform>();
+            Transform transform{};
 
             {
                 auto &helper = nodeTransform["m_LocalRotation"];
@@ -165,6 +188,8 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 transform.euler.y = helper["y"].as<float>();
                 transform.euler.z = helper["z"].as<float>();
             }
+
+            registry.commands().add<Transform>(entityIds[fileId], transform);
         } else if (auto const &nodeRectTransform = node["RectTransform"];
                    nodeRectTransform) {
             assert(
@@ -176,12 +201,10 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
             {
                 auto &helper = nodeRectTransform["m_GameObject"];
                 auto gameObjectFileId = helper["fileID"].Scalar();
-                Entity(entityIds[gameObjectFileId]).add<RectTransform>({});
                 entityIds.insert({fileId, entityIds[gameObjectFileId]});
             }
 
-            auto &rectTransform =
-                Entity(entityIds[fileId]).get<RectTransform>();
+            RectTransform rectTransform{};
 
             {
                 auto &helper = nodeRectTransform["m_AnchoredPosition"];
@@ -194,6 +217,9 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 rectTransform.size.x = helper["x"].as<float>();
                 rectTransform.size.y = helper["y"].as<float>();
             }
+
+            registry.commands().add<RectTransform>(entityIds[fileId],
+                                                   rectTransform);
         } else if (auto const &nodeMonoBehaviour = node["MonoBehaviour"];
                    nodeMonoBehaviour) {
             assert(
@@ -205,31 +231,12 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeMonoBehaviour["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    if (nodeMonoBehaviour["m_Text"]) {
-                        Entity(entityIds[gameObjectFileId])
-                            .add<UIElement>({.alpha = 1.0f});
-                    } else if (guidPaths.contains(
-                                   nodeMonoBehaviour["m_Script"]["guid"]
-                                       .as<std::string>())) {
-                        Entity(entityIds[gameObjectFileId]).add<Behaviour>({});
-                    }
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            if (Entity(entityIds[fileId]).has<Behaviour>()) {
-                auto &behaviour = Entity(entityIds[fileId]).get<Behaviour>();
-
-                {
-                    auto &helper = nodeMonoBehaviour["m_Script"];
-                    behaviour = registry.system<BehaviourSystem>()->behaviour(
-                        fs::path(guidPaths[helper["guid"].as<std::string>()])
-                            .stem()
-                            .string(),
-                        Entity(entityIds[fileId]));
-                }
-            } else if (Entity(entityIds[fileId]).has<UIElement>()) {
-                auto &uiElement = Entity(entityIds[fileId]).get<UIElement>();
+            if (nodeMonoBehaviour["m_Text"]) {
+                UIElement uiElement{.alpha = 1.0f};
 
                 {
                     auto &helper = nodeMonoBehaviour["m_Text"];
@@ -239,6 +246,18 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                     auto &helper = nodeMonoBehaviour["m_FontData"];
                     uiElement.fontSize = helper["m_FontSize"].as<int>();
                 }
+
+                registry.commands().add<UIElement>(entityIds[fileId],
+                                                   uiElement);
+            } else if (auto &helper = nodeMonoBehaviour["m_Script"];
+                       guidPaths.contains(helper["guid"].as<std::string>())) {
+                registry.commands().add<Behaviour>(
+                    entityIds[fileId],
+                    registry.system<BehaviourSystem>()->behaviour(
+                        fs::path(guidPaths[helper["guid"].as<std::string>()])
+                            .stem()
+                            .string(),
+                        Entity(entityIds[fileId])));
             }
         } else if (auto const &nodeMeshRenderer = node["MeshRenderer"];
                    nodeMeshRenderer) {
@@ -251,13 +270,11 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeMeshRenderer["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<Renderer>({});
-                    Entity(entityIds[gameObjectFileId]).add<AABB>({});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            auto &renderer = Entity(entityIds[fileId]).get<Renderer>();
+            Renderer renderer{};
 
             {
                 auto &helper = nodeMeshRenderer["m_Materials"];
@@ -316,6 +333,9 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                     }
                 }
             }
+
+            registry.commands().add<Renderer>(entityIds[fileId], renderer);
+            registry.commands().add<AABB>(entityIds[fileId], {});
         } else if (auto const &nodeMeshFilter = node["MeshFilter"];
                    nodeMeshFilter) {
             assert(nodeMeshFilter["m_GameObject"] && nodeMeshFilter["m_Mesh"] &&
@@ -325,12 +345,11 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeMeshFilter["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<MeshFilter>({});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            auto &meshFilter = Entity(entityIds[fileId]).get<MeshFilter>();
+            MeshFilter meshFilter{};
 
             {
                 auto &helper = nodeMeshFilter["m_Mesh"];
@@ -343,23 +362,32 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                     }
                 }
             }
+
+            registry.commands().add<MeshFilter>(entityIds[fileId], meshFilter);
         } else if (auto const &nodeBoxCollider = node["BoxCollider"];
                    nodeBoxCollider) {
             assert(
                 nodeBoxCollider["m_Size"] && nodeBoxCollider["m_Center"] &&
                 "Every property inside BoxCollider component must be valid!");
 
+            BoxCollider boxCollider{};
+
             {
                 auto &helper = nodeBoxCollider["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<BoxCollider>({});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
+
+                    // The layer belongs to the game object in Unity
+                    if (auto const &nodeLayer =
+                            nodes.at(guid)[gameObjectFileId]["GameObject"]
+                                          ["m_Layer"];
+                        nodeLayer) {
+                        setLayer(boxCollider, nodeLayer.as<unsigned int>());
+                    }
                 }
             }
 
-            auto &boxCollider = Entity(entityIds[fileId]).get<BoxCollider>();
-
             {
                 auto &helper = nodeBoxCollider["m_Size"];
                 boxCollider.size.x = helper["x"].as<float>();
@@ -373,6 +401,9 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 boxCollider.center.y = helper["y"].as<float>();
                 boxCollider.center.z = helper["z"].as<float>();
             }
+
+            registry.commands().add<BoxCollider>(entityIds[fileId],
+                                                 boxCollider);
         } else if (auto const &nodeSphereCollider = node["SphereCollider"];
                    nodeSphereCollider) {
             assert(nodeSphereCollider["m_Radius"] &&
@@ -384,13 +415,11 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeSphereCollider["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<SphereCollider>({});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            auto &sphereCollider =
-                Entity(entityIds[fileId]).get<SphereCollider>();
+            SphereCollider sphereCollider{};
 
             {
                 auto &helper = nodeSphereCollider["m_Radius"];
@@ -403,6 +432,9 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 sphereCollider.center.y = helper["y"].as<float>();
                 sphereCollider.center.z = helper["z"].as<float>();
             }
+
+            registry.commands().add<SphereCollider>(entityIds[fileId],
+                                                    sphereCollider);
         } else if (auto const &nodeRigidbody = node["Rigidbody"];
                    nodeRigidbody) {
             assert(nodeRigidbody["m_Mass"] &&
@@ -413,17 +445,18 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeRigidbody["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<Rigidbody>({});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            auto &rigidbody = Entity(entityIds[fileId]).get<Rigidbody>();
+            Rigidbody rigidbody{};
 
             {
                 auto &helper = nodeRigidbody["m_Mass"];
                 rigidbody.mass = helper.as<float>();
             }
+
+            registry.commands().add<Rigidbody>(entityIds[fileId], rigidbody);
         } else if (auto const &nodeSkybox = node["Skybox"]; nodeSkybox) {
             assert(
                 nodeSkybox["m_GameObject"] && nodeSkybox["m_CustomSkybox"] &&
@@ -433,14 +466,13 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 auto &helper = nodeSkybox["m_GameObject"];
                 yamlLoop(i, helper) {
                     auto gameObjectFileId = i->second.Scalar();
-                    Entity(entityIds[gameObjectFileId]).add<Skybox>({});
                     // cachedSkyboxes.insert({entityIds[gameObjectFileId],
                     // {}});
                     entityIds.insert({fileId, entityIds[gameObjectFileId]});
                 }
             }
 
-            auto &skybox = Entity(entityIds[fileId]).get<Skybox>();
+            Skybox skybox{};
             // auto &renderer = cachedRenderers.at(entityIds[fileId]);
 
             {
@@ -497,9 +529,15 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                     }
                 }
             }
+
+            registry.commands().add<Skybox>(entityIds[fileId], skybox);
         }
     }
 
+    // Every entity of the file joins the systems once, with all of its
+    // components, instead of once per component
+    registry.applyCommands();
+
     /* std::set<FileId> usedFileIds; */
     for (auto const &fileId : fileIds) {
         auto const &node = nodes.at(guid)[fileId];
@@ -578,6 +616,12 @@ std::unordered_map<FileId, EntityId> spawnPrefab(
                 } else if (property == "m_IsActive") {
                     properties.active =
                         static_cast<bool>((*i)["value"].as<int>());
+                } else if (property == "m_Layer") {
+                    if (auto entity = Entity(prefabEntityIds.at(targetFileId));
+                        entity.has<BoxCollider>()) {
+                        setLayer(entity.get<BoxCollider>(),
+                                 (*i)["value"].as<unsigned int>());
+                    }
                 }
             }
         }
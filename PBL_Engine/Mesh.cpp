@@ -4,9 +4,9 @@
 #include <assimp/postprocess.h>
 
 #include <array>
+#include <future>
 #include <sstream>
 #include <string_view>
-#include <thread>
 #include <unordered_map>
 
 #include "BonesCbuf.h"
@@ -399,29 +399,20 @@ Model::Model(Graphics& gfx, const std::string fileName, Renderer* renderer,
     int textureSlot = 0;
     // Textures
     if (renderer) {
-        // Load the PBR textures
-        std::vector<std::unique_ptr<SurfaceReference>> surfaces(5);
-        std::vector<std::thread> threads;
-        threads.push_back(std::thread([&surfaces, &renderer] {
-            surfaces[0] = std::make_unique<SurfaceReference>(
-                Surface::FromFile(renderer->material.albedoPath));
-        }));
-        threads.push_back(std::thread([&surfaces, &renderer] {
-            surfaces[1] = std::make_unique<SurfaceReference>(
-                Surface::FromFile(renderer->material.ambientOcclusionPath));
-        }));
-        threads.push_back(std::thread([&surfaces, &renderer] {
-            surfaces[2] = std::make_unique<SurfaceReference>(
-                Surface::FromFile(renderer->material.metallicSmoothnessPath));
-        }));
-        threads.push_back(std::thread([&surfaces, &renderer] {
-            surfaces[3] = std::make_unique<SurfaceReference>(
-                Surface::FromFile(renderer->material.normalPath));
-        }));
-        threads.push_back(std::thread([&surfaces, &renderer] {
-            surfaces[4] = std::make_unique<SurfaceReference>(
-                Surface::FromFile(renderer->material.heightPath));
-        }));
+        // Load the PBR textures. Reading the files blocks, so they're read
+        // on threads of their own rather than as jobs
+        std::vector<std::future<std::unique_ptr<SurfaceReference>>> surfaces;
+        auto const loadSurface = [&surfaces](std::string const& path) {
+            surfaces.push_back(std::async(std::launch::async, [path] {
+                return std::make_unique<SurfaceReference>(
+                    Surface::FromFile(path));
+            }));
+        };
+        loadSurface(renderer->material.albedoPath);
+        loadSurface(renderer->material.ambientOcclusionPath);
+        loadSurface(renderer->material.metallicSmoothnessPath);
+        loadSurface(renderer->material.normalPath);
+        loadSurface(renderer->material.heightPath);
 
         // Load the cubemap
         std::vector<std::unique_ptr<SurfaceReference>> cubeMapFaces(6);
@@ -450,17 +441,10 @@ Model::Model(Graphics& gfx, const std::string fileName, Renderer* renderer,
             cubeMap[i] = cubeMapFaces[i].get();
         }
 
-        // Synchronize the threads
-        for (auto& thread : threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
-        }
-
-        // Create the textures
+        // Create the textures, waiting for the surfaces still being read
         for (textureSlot = 0; textureSlot < surfaces.size(); ++textureSlot) {
             textures.push_back(std::make_shared<Texture>(
-                gfx, *surfaces[textureSlot], textureSlot));
+                gfx, *surfaces[textureSlot].get(), textureSlot));
         }
         textures.push_back(
             std::make_shared<Texture>(gfx, cubeMap, ++textureSlot));
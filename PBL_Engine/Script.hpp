@@ -1,7 +1,10 @@
 #pragma once
 
 // ///////////////////////////////////////////////////////////////// Includes //
+#include <vector>
+
 #include "ECS/Entity.hpp"
+#include "ECS/EventManager.hpp"
 #include "EngineAPI.hpp"
 
 // //////////////////////////////////////////////////////////////////// Class //
@@ -9,16 +12,33 @@ class ENGINE_API Script {
   public:
     // ========================================================= Behaviour == //
     Script(Entity const& entity) : entity(entity) {}
-    virtual ~Script() = default;
+    virtual ~Script() {
+        if (EventManager::exists()) {
+            for (auto const& listenerId : listenerIds) {
+                registry.unlisten(listenerId);
+            }
+        }
+    }
 
     virtual void setup(){};
     virtual void update(float const deltaTime){};
 
   protected:
+    // ========================================================= Behaviour == //
+    // Listeners subscribed this way are removed together with the script
+    template <typename EventType>
+    void listen(EventListener<EventType> const& listener) {
+        listenerIds.push_back(registry.listen(listener));
+    }
+
     // ============================================================== Data == //
     Entity entity;
 
     static inline Registry& registry = Registry::instance();
+
+  private:
+    // ============================================================== Data == //
+    std::vector<ListenerId> listenerIds;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,78 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "SeparationSums.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "JobSystem.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+SeparationSums::Sum SeparationSums::separation(
+    EntityId const entityId, DirectX::XMFLOAT3 const& vector) {
+    auto const counted = [](float const axis) {
+        return std::abs(axis) > 0.0f ? 1.0f : 0.0f;
+    };
+    return {.entityId = entityId,
+            .vector = vector,
+            .count = {counted(vector.x), counted(vector.y),
+                      counted(vector.z)}};
+}
+
+void SeparationSums::accumulate(
+    size_t const pairs,
+    std::function<void(size_t, std::vector<Sum>&)> const& separations) {
+    auto const chunkCount = (pairs + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (chunks.size() < chunkCount) {
+        chunks.resize(chunkCount);
+    }
+
+    JobSystem::instance().parallelFor(
+        chunkCount,
+        [this, pairs, &separations](size_t const chunk) {
+            auto& buffer = chunks[chunk];
+            buffer.clear();
+            auto const end = std::min((chunk + 1) * CHUNK_SIZE, pairs);
+            for (auto i = chunk * CHUNK_SIZE; i < end; ++i) {
+                separations(i, buffer);
+            }
+            merge(buffer);
+        },
+        1);
+
+    totals.clear();
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        totals.insert(totals.end(), chunks[chunk].begin(), chunks[chunk].end());
+    }
+    merge(totals);
+}
+
+// ------------------------------------------------------------ Helpers -- == //
+void SeparationSums::merge(std::vector<Sum>& sums) {
+    std::stable_sort(sums.begin(), sums.end(),
+                     [](Sum const& a, Sum const& b) {
+                         return a.entityId < b.entityId;
+                     });
+
+    auto last = sums.begin();
+    for (auto it = sums.begin(); it != sums.end(); ++it) {
+        if (it == last) {
+            continue;
+        }
+        if (it->entityId != last->entityId) {
+            *++last = *it;
+            continue;
+        }
+        last->vector.x += it->vector.x;
+        last->vector.y += it->vector.y;
+        last->vector.z += it->vector.z;
+        last->count.x += it->count.x;
+        last->count.y += it->count.y;
+        last->count.z += it->count.z;
+    }
+    if (!sums.empty()) {
+        sums.erase(last + 1, sums.end());
+    }
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,51 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <functional>
+#include <vector>
+
+#include "ECS/Utilities.hpp"
+#include "EngineAPI.hpp"
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Separating vectors of the colliders summed up per entity, together with
+// the number of vectors pushing along each axis. The pairs are split into
+// chunks of a fixed size, each summed up on a worker into its own buffer.
+// The buffers are added up in the order of the chunks, so the sums come out
+// the same whatever the number of threads
+class ENGINE_API SeparationSums {
+  public:
+    // ============================================================== Data == //
+    struct Sum {
+        EntityId entityId;
+        DirectX::XMFLOAT3 vector, count;
+    };
+
+    static constexpr size_t CHUNK_SIZE = 256u;
+
+    // ========================================================= Behaviour == //
+    static Sum separation(EntityId entityId, DirectX::XMFLOAT3 const& vector);
+
+    // The function adds the separations of the pair with the given index to
+    // the buffer, it's called from the workers
+    void accumulate(
+        size_t pairs,
+        std::function<void(size_t, std::vector<Sum>&)> const& separations);
+
+    // Sums of the last accumulate, one for every entity which got any,
+    // sorted by the entities
+    std::vector<Sum> const& sums() const { return totals; }
+
+  private:
+    // -------------------------------------------------------- Helpers -- == //
+    // Adds up the sums of the same entities, in the order they were given
+    static void merge(std::vector<Sum>& sums);
+
+    // ============================================================== Data == //
+    std::vector<std::vector<Sum>> chunks;
+    std::vector<Sum> totals;
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
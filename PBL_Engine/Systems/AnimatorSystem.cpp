@@ -7,7 +7,13 @@
 // /////////////////////////////////////////////////////////////////// System //
 // ============================================================= Behaviour == //
 // ----------------------------------------- System's virtual functions -- == //
-void AnimatorSystem::filters() { filter<Active>().filter<Animator>(); }
+void AnimatorSystem::filters() {
+    filter<Active>().filter<Animator>();
+    write<Animator>();
+
+    // Animations advance independently, the order doesn't matter
+    entities.keepSorted(false);
+}
 
 void AnimatorSystem::setup() {}
 
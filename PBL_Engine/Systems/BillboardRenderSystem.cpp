@@ -38,7 +38,7 @@ void BillboardRenderSystem::update(float deltaTime) {
         DirectX::XMFLOAT4 positionWorld;
         DirectX::XMStoreFloat4(&positionWorld, positionWorldVector);
 
-        auto const &tag = entity.get<Properties>().tag;
+        auto const &tag = registry.peek<Properties>(entity.id).tag;
         if (tag == "Torch") {
             auto const &light = entity.get<Light>().pointLight;
             flame->pos = light->lightPositionWorld();
@@ -1,7 +1,11 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include "ColliderSystem.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 #include "Cube.h"
+#include "JobSystem.hpp"
 #include "Renderable.h"
 #include "Window.h"
 #include "math.h"
@@ -10,6 +14,8 @@
 #include "Components/Components.hpp"
 #include "ECS/ECS.hpp"
 #include "Events/OnCollisionEnter.hpp"
+#include "Events/OnCollisionExit.hpp"
+#include "Events/OnCollisionStay.hpp"
 #include "Systems/CheckCollisionsSystem.hpp"
 #include "Systems/GraphSystem.hpp"
 #include "Systems/RenderSystem.hpp"
@@ -123,44 +129,46 @@ AABB ColliderSystem::AddAABB(
 
 void ColliderSystem::CalculateAABB(AABB& aabb,
                                    DirectX::XMMATRIX const& worldSpace) {
-    DirectX::XMFLOAT3 minVertex = DirectX::XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
-    DirectX::XMFLOAT3 maxVertex =
-        DirectX::XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
-    // Loop through the 8 vertices describing the bounding box
-    for (size_t i = 0; i < aabb.vertices.size(); i++) {
-        // Transform the bounding boxes vertices to the objects world space
-        DirectX::XMVECTOR Vert = DirectX::XMVectorSet(
-            aabb.vertices[i].x, aabb.vertices[i].y, aabb.vertices[i].z, 0.0f);
-        Vert = XMVector3TransformCoord(Vert, worldSpace);
-
-        // Get the smallest vertex
-        minVertex.x = std::min(
-            minVertex.x,
-            DirectX::XMVectorGetX(Vert));  // Find smallest x value in model
-        minVertex.y = std::min(
-            minVertex.y,
-            DirectX::XMVectorGetY(Vert));  // Find smallest y value in model
-        minVertex.z = std::min(
-            minVertex.z,
-            DirectX::XMVectorGetZ(Vert));  // Find smallest z value in model
-
-        // Get the largest vertex
-        maxVertex.x = std::max(
-            maxVertex.x,
-            DirectX::XMVectorGetX(Vert));  // Find largest x value in model
-        maxVertex.y = std::max(
-            maxVertex.y,
-            DirectX::XMVectorGetY(Vert));  // Find largest y value in model
-        maxVertex.z = std::max(
-            maxVertex.z,
-            DirectX::XMVectorGetZ(Vert));  // Find largest z value in model
-    }
+    // The first and the seventh vertex are the local minimum and maximum
+    auto const localMin = DirectX::XMLoadFloat3(&aabb.vertices[0]);
+    auto const localMax = DirectX::XMLoadFloat3(&aabb.vertices[6]);
+    auto const center = DirectX::XMVector3Transform(
+        DirectX::XMVectorScale(DirectX::XMVectorAdd(localMin, localMax), 0.5f),
+        worldSpace);
+    auto const extent = DirectX::XMVectorScale(
+        DirectX::XMVectorSubtract(localMax, localMin), 0.5f);
+
+    // Every axis of the box adds its absolute projection on the world axes,
+    // which gives the same bounds as transforming all the eight vertices
+    auto worldExtent = DirectX::XMVectorMultiply(
+        DirectX::XMVectorSplatX(extent), DirectX::XMVectorAbs(worldSpace.r[0]));
+    worldExtent = DirectX::XMVectorMultiplyAdd(
+        DirectX::XMVectorSplatY(extent), DirectX::XMVectorAbs(worldSpace.r[1]),
+        worldExtent);
+    worldExtent = DirectX::XMVectorMultiplyAdd(
+        DirectX::XMVectorSplatZ(extent), DirectX::XMVectorAbs(worldSpace.r[2]),
+        worldExtent);
 
     // Store Bounding Box's min and max vertices
     aabb.vertexMin =
-        DirectX::XMVectorSet(minVertex.x, minVertex.y, minVertex.z, 0.0f);
+        DirectX::XMVectorSetW(DirectX::XMVectorSubtract(center, worldExtent),
+                              0.0f);
     aabb.vertexMax =
-        DirectX::XMVectorSet(maxVertex.x, maxVertex.y, maxVertex.z, 0.0f);
+        DirectX::XMVectorSetW(DirectX::XMVectorAdd(center, worldExtent), 0.0f);
+}
+
+void ColliderSystem::RefreshAABB(AABB& aabb, Entity const& entity) {
+    // New bounds have no version, the graph starts counting from one. The
+    // transforms moved by the last fixed step change between the frames
+    // without a new version, as they're blended towards the current pose
+    auto const worldVersion = graphSystem->worldVersion(entity);
+    auto const interpolation = graphSystem->interpolation(entity);
+    if (aabb.worldVersion != worldVersion ||
+        aabb.interpolation != interpolation) {
+        CalculateAABB(aabb, graphSystem->transform(entity));
+        aabb.worldVersion = worldVersion;
+        aabb.interpolation = interpolation;
+    }
 }
 
 BoxCollider ColliderSystem::AddBoxCollider(BoxCollider boxCollider) {
@@ -258,44 +266,12 @@ BoxCollider ColliderSystem::AddBoxCollider(BoxCollider boxCollider) {
 
 bool ColliderSystem::CheckBoxesCollision(
     BoxCollider const& boxCollider, BoxCollider const& differentBoxCollider) {
-    // Is obj1's max X greater than obj2's min X? If not, obj1 is to the
-    // LEFT of obj2
-    if (DirectX::XMVectorGetX(boxCollider.aabb.vertexMax) >
-        DirectX::XMVectorGetX(differentBoxCollider.aabb.vertexMin))
-
-        // Is obj1's min X less than obj2's max X? If not, obj1 is to the
-        // RIGHT of obj2
-        if (DirectX::XMVectorGetX(boxCollider.aabb.vertexMin) <
-            DirectX::XMVectorGetX(differentBoxCollider.aabb.vertexMax))
-
-            // Is obj1's max Y greater than obj2's min Y? If not, obj1 is
-            // UNDER obj2
-            if (DirectX::XMVectorGetY(boxCollider.aabb.vertexMax) >
-                DirectX::XMVectorGetY(differentBoxCollider.aabb.vertexMin))
-
-                // Is obj1's min Y less than obj2's max Y? If not, obj1 is
-                // ABOVE obj2
-                if (DirectX::XMVectorGetY(boxCollider.aabb.vertexMin) <
-                    DirectX::XMVectorGetY(differentBoxCollider.aabb.vertexMax))
-
-                    // Is obj1's max Z greater than obj2's min Z? If not,
-                    // obj1 is IN FRONT OF obj2
-                    if (DirectX::XMVectorGetZ(boxCollider.aabb.vertexMax) >
-                        DirectX::XMVectorGetZ(
-                            differentBoxCollider.aabb.vertexMin))
-
-                        // Is obj1's min Z less than obj2's max Z? If not,
-                        // obj1 is BEHIND obj2
-                        if (DirectX::XMVectorGetZ(boxCollider.aabb.vertexMin) <
-                            DirectX::XMVectorGetZ(
-                                differentBoxCollider.aabb.vertexMax))
-
-                            // If we've made it this far, then the two
-                            // bounding boxes are colliding
-                            return true;
-
-    // If the two bounding boxes are not colliding, then return false
-    return false;
+    // The boxes overlap if on every axis each one ends past the start of the
+    // other, all the axes are compared at once
+    return DirectX::XMVector3Greater(boxCollider.aabb.vertexMax,
+                                     differentBoxCollider.aabb.vertexMin) &&
+           DirectX::XMVector3Less(boxCollider.aabb.vertexMin,
+                                  differentBoxCollider.aabb.vertexMax);
 }
 
 SphereCollider ColliderSystem::AddSphereCollider(
@@ -400,6 +376,62 @@ DirectX::XMFLOAT3 ColliderSystem::CalculateSeparatingVector(
                              ((z[0] < z[1]) ? 1 : -1) * minZ);
 }
 
+void ColliderSystem::Separate(Entity const& entity, Entity const& other) {
+    auto const [first, second] = std::minmax(entity.id, other.id);
+    BroadPhase::Pair const pair{first, second};
+    auto const it = std::lower_bound(pairs.begin(), pairs.end(), pair);
+    assert(it != pairs.end() && *it == pair &&
+           "Only the colliding entities can be separated");
+
+    auto& collision = collisions[it - pairs.begin()];
+    assert(collision.touching &&
+           "Only the colliding entities can be separated");
+    (entity.id == first ? collision.separateFirst : collision.separateSecond) =
+        true;
+}
+
+void ColliderSystem::SetBroadPhase(std::unique_ptr<BroadPhase> broadPhase) {
+    this->broadPhase = std::move(broadPhase);
+}
+
+std::vector<EntityId> ColliderSystem::OverlapBox(
+    DirectX::XMFLOAT3 const& min, DirectX::XMFLOAT3 const& max) {
+    std::vector<EntityId> entityIds;
+    broadPhase->overlapBox(proxies, min, max, [&](EntityId const entityId) {
+        entityIds.push_back(entityId);
+    });
+    return entityIds;
+}
+
+std::vector<EntityId> ColliderSystem::OverlapSphere(
+    DirectX::XMFLOAT3 const& center, float const radius) {
+    std::vector<EntityId> entityIds;
+    broadPhase->overlapBox(
+        proxies,
+        {center.x - radius, center.y - radius, center.z - radius},
+        {center.x + radius, center.y + radius, center.z + radius},
+        [&](EntityId const entityId) {
+            // Distance from the center to the closest point of the box
+            auto const& aabb = registry.peek<BoxCollider>(entityId).aabb;
+            auto const point = DirectX::XMLoadFloat3(&center);
+            auto const closest = DirectX::XMVectorClamp(
+                point, aabb.vertexMin, aabb.vertexMax);
+            auto const distance = DirectX::XMVectorGetX(
+                DirectX::XMVector3LengthSq(
+                    DirectX::XMVectorSubtract(point, closest)));
+            if (distance < radius * radius) {
+                entityIds.push_back(entityId);
+            }
+        });
+    return entityIds;
+}
+
+std::optional<BroadPhase::Hit> ColliderSystem::Raycast(
+    DirectX::XMFLOAT3 const& origin, DirectX::XMFLOAT3 const& direction,
+    float const maxDistance) {
+    return broadPhase->raycast(proxies, origin, direction, maxDistance);
+}
+
 void ColliderSystem::filters() {
     filter<Active>();
     filter<BoxCollider>();
@@ -408,43 +440,122 @@ void ColliderSystem::filters() {
 void ColliderSystem::setup() {
     graphSystem = registry.system<GraphSystem>();
     checkCollisionsSystem = registry.system<CheckCollisionsSystem>();
+
+    // Listeners get all the collisions of a frame at once, after the pairs
+    // have been checked, so they can't change the colliders mid-iteration
+    registry.queue<OnCollisionEnter>();
+    registry.queue<OnCollisionStay>();
+    registry.queue<OnCollisionExit>();
 }
 
 void ColliderSystem::release() {}
 
 void ColliderSystem::update(float deltaTime) {
+    proxies.clear();
     for (auto entity : entities) {
         auto& boxCollider = entity.get<BoxCollider>();
 
-        CalculateAABB(boxCollider.aabb, graphSystem->transform(entity));
+        RefreshAABB(boxCollider.aabb, entity);
 
         boxCollider.separatingVectorSum = {0.0f, 0.0f, 0.0f};
         boxCollider.numberOfCollisions = {0.0f, 0.0f, 0.0f};
+
+        auto& proxy = proxies.emplace_back();
+        DirectX::XMStoreFloat3(&proxy.min, boxCollider.aabb.vertexMin);
+        DirectX::XMStoreFloat3(&proxy.max, boxCollider.aabb.vertexMax);
+        proxy.entityId = entity.id;
+        proxy.dynamic = checkCollisionsSystem->entities.contains(entity.id);
+        proxy.layers = boxCollider.layers;
+        proxy.mask = boxCollider.mask;
     }
 
-    std::set<std::pair<Entity, Entity>> checks;
-    for (auto iEntity : entities) {
-        for (auto jEntity : checkCollisionsSystem->entities) {
-            if (iEntity.id == jEntity.id) {
-                break;
-            }
+    // Only the colliders with CheckCollisions look for collisions, the
+    // pairs are sorted to keep the order of the events
+    pairs.clear();
+    broadPhase->findPairs(proxies, pairs);
+    std::sort(pairs.begin(), pairs.end());
+
+    // The pairs don't depend on each other, so they're checked in parallel.
+    // Every result has its own slot, the events are sent afterwards in the
+    // order of the pairs
+    collisions.resize(pairs.size());
+    JobSystem::instance().parallelFor(pairs.size(), [this](size_t const i) {
+        auto const& iBoxCollider = registry.peek<BoxCollider>(pairs[i].first);
+        auto const& jBoxCollider = registry.peek<BoxCollider>(pairs[i].second);
+        auto& collision = collisions[i];
+        collision.touching = CheckBoxesCollision(iBoxCollider, jBoxCollider);
+        collision.separateFirst = collision.separateSecond = false;
+        if (collision.touching) {
+            collision.minSeparatingVector =
+                CalculateSeparatingVector(iBoxCollider, jBoxCollider);
+        }
+    });
+
+    // Both the pairs and the contacts are sorted, so they're matched in one
+    // pass. The contacts left behind the current pair have just ended
+    auto const exit = [this](Contact const& contact) {
+        registry.send(OnCollisionExit{.a = contact.pair.first,
+                                      .b = contact.pair.second,
+                                      .duration = contact.duration});
+    };
+
+    nextContacts.clear();
+    auto contact = contacts.begin();
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        if (!collisions[i].touching) {
+            continue;
+        }
 
-            checks.insert({iEntity < jEntity ? iEntity : jEntity,
-                           iEntity < jEntity ? jEntity : iEntity});
+        auto const& pair = pairs[i];
+        auto const [iEntity, jEntity] = pair;
+        for (; contact != contacts.end() && contact->pair < pair; ++contact) {
+            exit(*contact);
         }
-    }
 
-    for (auto [iEntity, jEntity] : checks) {
-        auto iBoxCollider = iEntity.get<BoxCollider>();
-        auto jBoxCollider = jEntity.get<BoxCollider>();
-        if (CheckBoxesCollision(iBoxCollider, jBoxCollider)) {
-            registry.send(OnCollisionEnter{
-                .a = iEntity,
-                .b = jEntity,
-                .minSeparatingVector =
-                    CalculateSeparatingVector(iBoxCollider, jBoxCollider)});
+        auto const minSeparatingVector = collisions[i].minSeparatingVector;
+        if (contact != contacts.end() && contact->pair == pair) {
+            auto const duration = contact->duration + deltaTime;
+            registry.send(
+                OnCollisionStay{.a = iEntity,
+                                .b = jEntity,
+                                .minSeparatingVector = minSeparatingVector,
+                                .duration = duration});
+            nextContacts.push_back({.pair = pair, .duration = duration});
+            ++contact;
+        } else {
+            registry.send(
+                OnCollisionEnter{.a = iEntity,
+                                 .b = jEntity,
+                                 .minSeparatingVector = minSeparatingVector});
+            nextContacts.push_back({.pair = pair, .duration = 0.0f});
         }
     }
+    for (; contact != contacts.end(); ++contact) {
+        exit(*contact);
+    }
+    std::swap(contacts, nextContacts);
+
+    // Listeners pick the collisions to separate
+    registry.flush<OnCollisionEnter>();
+    registry.flush<OnCollisionStay>();
+
+    separationSums.accumulate(
+        pairs.size(), [this](size_t const i, auto& separations) {
+            auto const& collision = collisions[i];
+            if (collision.separateFirst) {
+                separations.push_back(SeparationSums::separation(
+                    pairs[i].first, collision.minSeparatingVector));
+            }
+            if (collision.separateSecond) {
+                separations.push_back(SeparationSums::separation(
+                    pairs[i].second, collision.minSeparatingVector));
+            }
+        });
+    for (auto const& sum : separationSums.sums()) {
+        auto& boxCollider = Entity(sum.entityId).get<BoxCollider>();
+        boxCollider.separatingVectorSum = sum.vector;
+        boxCollider.numberOfCollisions = sum.count;
+    }
 
     for (auto entity : checkCollisionsSystem->entities) {
         auto& boxCollider = entity.get<BoxCollider>();
@@ -463,4 +574,7 @@ void ColliderSystem::update(float deltaTime) {
         transform.position -=
             boxCollider.separatingVectorSum / boxCollider.numberOfCollisions;
     }
+
+    // The entities may be destroyed already
+    registry.flush<OnCollisionExit>();
 }
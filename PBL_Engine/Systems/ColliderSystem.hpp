@@ -5,6 +5,11 @@
 #include <DirectXMath.h>
 
 #include <memory>
+#include <optional>
+#include <vector>
+
+#include "BroadPhase.hpp"
+#include "SeparationSums.hpp"
 
 // ECS
 #include "Components/Components.hpp"
@@ -27,6 +32,8 @@ ECS_SYSTEM(ColliderSystem) {
     // AABB
     AABB AddAABB(std::vector<DirectX::XMFLOAT3> const& objectVertPos);
     void CalculateAABB(AABB & aabb, DirectX::XMMATRIX const& worldSpace);
+    // Recalculates the bounds only if the entity's world transform changed
+    void RefreshAABB(AABB & aabb, Entity const& entity);
 
     // Box Collider
     BoxCollider AddBoxCollider(BoxCollider boxCollider);
@@ -46,6 +53,25 @@ ECS_SYSTEM(ColliderSystem) {
     DirectX::XMFLOAT3 CalculateSeparatingVector(
         BoxCollider const& boxCollider,
         BoxCollider const& differentBoxCollider);
+
+    // Pushes the entity out of the other one at the end of the update, by
+    // the separating vector of their collision. Meant for the listeners of
+    // the collision events, which are sent during the update
+    void Separate(Entity const& entity, Entity const& other);
+
+    // The dynamic tree is used unless another broad phase is set
+    void SetBroadPhase(std::unique_ptr<BroadPhase> broadPhase);
+
+    // Queries on the colliders' boxes from the last update, the distances
+    // are measured in the lengths of the given direction
+    std::vector<EntityId> OverlapBox(DirectX::XMFLOAT3 const& min,
+                                     DirectX::XMFLOAT3 const& max);
+    std::vector<EntityId> OverlapSphere(DirectX::XMFLOAT3 const& center,
+                                        float radius);
+    std::optional<BroadPhase::Hit> Raycast(DirectX::XMFLOAT3 const& origin,
+                                           DirectX::XMFLOAT3 const& direction,
+                                           float maxDistance);
+
     // ============================================================== Data == //
   public:
     // Box
@@ -56,5 +82,27 @@ ECS_SYSTEM(ColliderSystem) {
     float speed_factor = 1.0f;
     std::shared_ptr<GraphSystem> graphSystem;
     std::shared_ptr<CheckCollisionsSystem> checkCollisionsSystem;
+
+    std::unique_ptr<BroadPhase> broadPhase = std::make_unique<DynamicTree>();
+    std::vector<BroadPhase::Proxy> proxies;
+    std::vector<BroadPhase::Pair> pairs;
+
+    // Results of the precise checks, one for each pair, with the sides the
+    // listeners asked to separate
+    struct Collision {
+        bool touching;
+        DirectX::XMFLOAT3 minSeparatingVector;
+        bool separateFirst, separateSecond;
+    };
+    std::vector<Collision> collisions;
+    SeparationSums separationSums;
+
+    // Pairs overlapping in the last frame, sorted the same as the pairs, so
+    // each one gets a single enter, stay every frame after it and an exit
+    struct Contact {
+        BroadPhase::Pair pair;
+        float duration;
+    };
+    std::vector<Contact> contacts, nextContacts;
 };
 // ////////////////////////////////////////////////////////////////////////// //
@@ -4,233 +4,435 @@
 // ///////////////////////////////////////////////////////////////// Includes //
 #include "GraphSystem.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
-#include "Components/Components.hpp"
+#include "Components/Properties.hpp"
+#include "Components/Tags.hpp"
+#include "Components/Transform.hpp"
 #include "ECS/ECS.hpp"
+#include "JobSystem.hpp"
 
 // /////////////////////////////////////////////////////////////// Namespaces //
 namespace dx = DirectX;
 
-// //////////////////////////////////////////////////////////////// Operators //
-bool operator==(dx::XMFLOAT3 const& a, dx::XMFLOAT3 const& b) {
-    return a.x == b.x && a.y == b.y && a.z == b.z;
-}
-
-bool operator==(dx::XMFLOAT4 const& a, dx::XMFLOAT4 const& b) {
-    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
-}
-
-bool operator==(Transform const& a, Transform const& b) {
-    return a.parent == b.parent && a.rotation == b.rotation &&
-           a.position == b.position && a.scale == b.scale && a.euler == b.euler;
-}
-
-bool operator!=(Transform const& a, Transform const& b) { return !(a == b); }
-
 // /////////////////////////////////////////////////////////////////// System //
 // ============================================================= Behaviour == //
 // ----------------------------------------- System's virtual functions -- == //
 void GraphSystem::filters() { filter<Properties>().filter<Transform>(); }
 
 void GraphSystem::setup() {
-    // Set default values for the root node
-    root.parent = nullptr;
-    root.children.clear();
-    root.entity = std::nullopt;
-    root.transform = nullptr;
-    root.activity = nullptr;
-    root.cumulativeTransform = dx::XMMatrixIdentity();
-    root.cumulativeActivity = true;
-    root.recalculateTransforms = true;
-    root.recalculateActivity = true;
-
-    entityToGraphNode.clear();
-    entityToPreviousTransform.clear();
-    entityToPreviousActivity.clear();
-
-    // Create map entries for all entities (only when needed)
+    nodeEntities.clear();
+    parents.clear();
+    subtreeSizes.clear();
+    localTransforms.clear();
+    worldTransforms.clear();
+    previousWorldTransforms.clear();
+    worldActivities.clear();
+    changes.clear();
+    worldVersions.clear();
+    outsideVersions.clear();
+    entityToNode.clear();
+
+    std::vector<EntityId> entityIds;
     for (Entity entity : entities) {
-        if (!entityToGraphNode.contains(entity.id)) {
-            entityToGraphNode.insert(
-                {entity.id,
-                 {.parent = nullptr,
-                  .children = {},
-                  .entity = std::make_optional<Entity>(entity.id),
-                  .transform = &entity.get<Transform>(),
-                  .activity = &entity.get<Properties>().active,
-                  .cumulativeTransform = dx::XMMatrixIdentity(),
-                  .cumulativeActivity = entity.get<Properties>().active,
-                  .recalculateTransforms = true,
-                  .recalculateActivity = true}});
-            entityToPreviousTransform.insert(
-                {entity.id, entity.get<Transform>()});
-            entityToPreviousActivity.insert(
-                {entity.id, entity.get<Properties>().active});
-        }
+        entityIds.push_back(entity.id);
     }
+    attach(entityIds);
+
+    // Every node is already marked as changed
+    transformVersion = registry.eachChanged<Transform>(
+        transformVersion, [](EntityId) {});
+    activityVersion = registry.eachChanged<Properties>(
+        activityVersion, [](EntityId) {});
+    propagate();
+}
 
-    // Construct the parent-child relationships between the graph nodes
-    for (auto& [entityId, graphNode] : entityToGraphNode) {
-        auto const& entity = Entity(entityId);
-        //if (!entities.contains(entity)) {
-        //    continue;
-        //}
-
-        auto const& transform = entity.get<Transform>();
+void GraphSystem::update(float) { refresh(); }
 
-        if (transform.parent) {
-            auto const& parentId = *transform.parent;
-            auto const& parent = Entity(parentId);
+void GraphSystem::release() {}
 
-            if (!graphNode.parent) {
-                graphNode.parent = &entityToGraphNode.at(parentId);
-            }
-            if (!graphNode.parent->children.contains(entityId)) {
-                graphNode.parent->children.insert(entityId);
-            }
-        } else {
-            if (!graphNode.parent) {
-                graphNode.parent = &root;
-            }
-            if (!root.children.contains(entityId)) {
-                root.children.insert(entityId);
-            }
-        }
+DirectX::XMMATRIX GraphSystem::transform(Entity const& entity) {
+    auto const node = entityToNode.get(entity.id);
+    auto const fraction = interpolation(entity);
+    if (fraction >= 1.0f) {
+        return worldTransforms[node];
     }
 
-
-    update(0.0f);
+    auto const& previous = previousWorldTransforms[node];
+    auto const& current = worldTransforms[node];
+    return dx::XMMATRIX(
+        dx::XMVectorLerp(previous.r[0], current.r[0], fraction),
+        dx::XMVectorLerp(previous.r[1], current.r[1], fraction),
+        dx::XMVectorLerp(previous.r[2], current.r[2], fraction),
+        dx::XMVectorLerp(previous.r[3], current.r[3], fraction));
 }
 
-void GraphSystem::update(float const deltaTime) {
-    // Check for transformations that need to be recalculated
-    for (auto const& [entityId, previousTransform] :
-         entityToPreviousTransform) {
-        auto const& entity = Entity(entityId);
-        //if (!entities.contains(entity)) {
-        //    continue;
-        //}
+float GraphSystem::interpolation(Entity const& entity) {
+    auto const node = entityToNode.get(entity.id);
+    auto const version = worldVersions.at(node);
+    if (version < stepBegin || version > stepEnd ||
+        outsideVersions[node] >= frameBegin) {
+        return 1.0f;
+    }
+    return std::min(stepFraction, 1.0f);
+}
 
-        auto const& currentTransform = entity.get<Transform>();
+ChangeVersion GraphSystem::worldVersion(Entity const& entity) {
+    return worldVersions.at(entityToNode.get(entity.id));
+}
 
-        if (currentTransform != previousTransform) {
-            entityToGraphNode.at(entityId).recalculateTransforms = true;
-            entityToPreviousTransform.at(entityId) = currentTransform;
-        }
+void GraphSystem::destroyEntityWithChildren(Entity const& entity) {
+    auto const node = entityToNode.get(entity.id);
+    if (node == EMPTY_ENTITY) {
+        registry.destroyEntity(entity);
+        return;
     }
 
-    // Check for activities that need to be recalculated
-    for (auto const& [entityId, previousActivity] : entityToPreviousActivity) {
-        auto const& entity = Entity(entityId);
-        //if (!entities.contains(entity)) {
-        //    continue;
-        //}
-
-        auto const& currentActivity = entity.get<Properties>().active;
+    // The entity's children are stored right after it
+    for (auto i = node; i < node + subtreeSizes[node]; ++i) {
+        registry.destroyEntity(Entity(nodeEntities[i]));
+    }
+}
 
-        if (currentActivity != previousActivity) {
-            entityToGraphNode.at(entityId).recalculateActivity = true;
-            entityToPreviousActivity.at(entityId) = currentActivity;
-        }
+void GraphSystem::beginStep() {
+    // The changes made since the last frame outside the steps, by the scripts
+    // mostly, are taken in before the first step. Blending these would draw
+    // them back towards the poses from before them
+    if (!stepping) {
+        frameBegin = propagationVersion + 1;
+        refresh();
+        stepping = true;
     }
+    stepBegin = propagationVersion + 1;
+    stepFraction = 1.0f;
+}
 
-    // Update transformations and activities
-    std::queue<std::reference_wrapper<GraphNode>> nodes;
-    for (auto const& childEntityId : root.children) {
-        nodes.push(std::ref(entityToGraphNode.at(childEntityId)));
+void GraphSystem::interpolate(float const fraction) {
+    if (stepping) {
+        stepEnd = propagationVersion;
+        stepping = false;
     }
+    stepFraction = fraction;
+}
 
-    while (!nodes.empty()) {
-        auto& node = nodes.front().get();
-        nodes.pop();
+void GraphSystem::refresh() {
+    // Check for transformations and activities that need to be recalculated,
+    // the activity is a part of the properties. Components are stamped when
+    // they're added, so the spawned entities show up here too
+    std::vector<EntityId> spawned, reparented;
+    transformVersion = registry.eachChanged<Transform>(
+        transformVersion, [this, &spawned, &reparented](EntityId entityId) {
+            auto const node = entityToNode.get(entityId);
+            if (node == EMPTY_ENTITY) {
+                if (entities.contains(entityId)) {
+                    spawned.push_back(entityId);
+                }
+                return;
+            }
+            changes[node] |= LOCAL_TRANSFORM | WORLD_TRANSFORM;
 
-        if (node.recalculateTransforms) {
-            node.cumulativeTransform = dx::XMMatrixIdentity();
-            node.cumulativeTransform *= matrix(*node.transform);
-            node.cumulativeTransform *= node.parent->cumulativeTransform;
-        }
-        if (node.recalculateActivity) {
-            if (node.parent->cumulativeActivity) {
-                node.cumulativeActivity = *node.activity;
-            } else {
-                node.cumulativeActivity = false;
+            auto const& parent = registry.peek<Transform>(entityId).parent;
+            auto const parentNode =
+                parent ? entityToNode.get(*parent) : NO_PARENT;
+            if (parentNode != parents[node]) {
+                reparented.push_back(entityId);
             }
-            if (node.entity->has<Active>()) {
-                if (!node.cumulativeActivity) {
-                    node.entity->remove<Active>();
-                }
-            } else {
-                if (node.cumulativeActivity) {
-                    node.entity->add<Active>({});
+        });
+    activityVersion = registry.eachChanged<Properties>(
+        activityVersion, [this, &spawned](EntityId entityId) {
+            auto const node = entityToNode.get(entityId);
+            if (node == EMPTY_ENTITY) {
+                if (entities.contains(entityId)) {
+                    spawned.push_back(entityId);
                 }
+                return;
             }
-        }
+            changes[node] |= ACTIVITY;
+        });
+
+    std::sort(spawned.begin(), spawned.end());
+    spawned.erase(std::unique(spawned.begin(), spawned.end()), spawned.end());
+
+    // Every entity of the system has a node, so a node without an entity
+    // shows up as a difference in the sizes
+    auto const destroyed =
+        nodeEntities.size() + spawned.size() != entities.size();
 
-        for (auto const& childEntityId : node.children) {
-            auto& childGraphNode = entityToGraphNode.at(childEntityId);
-            childGraphNode.recalculateTransforms |= node.recalculateTransforms;
-            childGraphNode.recalculateActivity |= node.recalculateActivity;
-            nodes.push(std::ref(childGraphNode));
+    auto const nested = attach(spawned);
+
+    // The new parents may have been spawned in the meantime
+    for (auto const entityId : reparented) {
+        auto const node = entityToNode.get(entityId);
+        auto const& parent = registry.peek<Transform>(entityId).parent;
+        parents[node] = parent ? entityToNode.get(*parent) : NO_PARENT;
+        changes[node] |= WORLD_TRANSFORM | ACTIVITY;
+    }
+
+    if (nested || destroyed || !reparented.empty()) {
+        relayout();
+    }
+    propagate();
+}
+
+// ------------------------------------------------------------ Helpers -- == //
+bool GraphSystem::attach(std::vector<EntityId> const& entityIds) {
+    // Group the entities by their parents, the ones without a new parent
+    // start their own subtrees
+    std::vector<EntityId> roots;
+    std::unordered_map<EntityId, std::vector<EntityId>> entityToChildren;
+    for (auto const entityId : entityIds) {
+        auto const& parent = registry.peek<Transform>(entityId).parent;
+        if (parent && std::binary_search(entityIds.begin(), entityIds.end(),
+                                         *parent)) {
+            entityToChildren[*parent].push_back(entityId);
+        } else {
+            roots.push_back(entityId);
         }
+    }
 
-        node.recalculateTransforms = false;
-        node.recalculateActivity = false;
+    // Lay the nodes out depth-first at the end, keeping the order of the
+    // identifiers
+    auto const first = static_cast<NodeIndex>(nodeEntities.size());
+    bool nested = false;
+    std::vector<std::pair<EntityId, NodeIndex>> pending;
+    for (auto root = roots.rbegin(); root != roots.rend(); ++root) {
+        auto const& parent = registry.peek<Transform>(*root).parent;
+        auto const parentNode = parent ? entityToNode.get(*parent) : NO_PARENT;
+        nested |= parentNode != NO_PARENT;
+        pending.push_back({*root, parentNode});
+    }
+    while (!pending.empty()) {
+        auto const [entityId, parent] = pending.back();
+        pending.pop_back();
+
+        auto const node = static_cast<NodeIndex>(nodeEntities.size());
+        entityToNode.set(entityId, node);
+        nodeEntities.push_back(entityId);
+        parents.push_back(parent);
+        subtreeSizes.push_back(1u);
+        localTransforms.push_back(dx::XMMatrixIdentity());
+        worldTransforms.push_back(dx::XMMatrixIdentity());
+        previousWorldTransforms.push_back(dx::XMMatrixIdentity());
+        worldActivities.push_back(false);
+        changes.push_back(LOCAL_TRANSFORM | WORLD_TRANSFORM | ACTIVITY);
+        worldVersions.push_back(0u);
+        outsideVersions.push_back(0u);
+
+        if (auto const children = entityToChildren.find(entityId);
+            children != entityToChildren.end()) {
+            for (auto child = children->second.rbegin();
+                 child != children->second.rend(); ++child) {
+                pending.push_back({*child, node});
+            }
+        }
     }
-};
 
-void GraphSystem::release() {}
+    // Children come after their parents, so the sizes can be summed up
+    // going backwards through the new nodes
+    for (auto node = static_cast<NodeIndex>(nodeEntities.size());
+         node-- > first;) {
+        if (parents[node] != NO_PARENT && parents[node] >= first) {
+            subtreeSizes[parents[node]] += subtreeSizes[node];
+        }
+    }
 
-DirectX::XMMATRIX GraphSystem::transform(Entity const& entity) {
-    return entityToGraphNode.at(entity.id).cumulativeTransform;
+    // Subtrees attached below the existing nodes need to be moved next to
+    // their parents
+    return nested;
 }
 
-void GraphSystem::destroyEntityWithChildren(Entity const& entity) {
-    // Destroy the entity
-    registry.destroyEntity(entity);
+void GraphSystem::relayout() {
+    auto const count = static_cast<NodeIndex>(nodeEntities.size());
 
-    // Destroy the entity's children if they exist
-    if (!entityToGraphNode.contains(entity.id)) {
-        return; 
+    // Link the children of every node, the nodes of the destroyed entities
+    // are left out and their children become roots
+    std::vector<std::uint8_t> kept(count);
+    for (NodeIndex node = 0; node < count; ++node) {
+        kept[node] = entities.contains(nodeEntities[node]);
+        entityToNode.reset(nodeEntities[node]);
     }
-    auto const& children = entityToGraphNode.at(entity.id).children;
-    if (!children.empty()) {
-        for (auto const& childEntityId : children) {
-            destroyEntityWithChildren(childEntityId);
+
+    std::vector<NodeIndex> roots;
+    std::vector<NodeIndex> firstChildren(count, NO_PARENT);
+    std::vector<NodeIndex> nextSiblings(count, NO_PARENT);
+    for (NodeIndex node = 0; node < count; ++node) {
+        if (!kept[node]) {
+            continue;
+        }
+        auto const parent = parents[node];
+        if (parent != NO_PARENT && parent < count && kept[parent]) {
+            nextSiblings[node] = firstChildren[parent];
+            firstChildren[parent] = node;
+        } else {
+            roots.push_back(node);
+        }
+    }
+
+    // Lay the nodes out depth-first again, keeping their previous order
+    std::vector<NodeIndex> order;
+    std::vector<NodeIndex> pending(roots.rbegin(), roots.rend());
+    while (!pending.empty()) {
+        auto const node = pending.back();
+        pending.pop_back();
+
+        order.push_back(node);
+        for (auto child = firstChildren[node]; child != NO_PARENT;
+             child = nextSiblings[child]) {
+            pending.push_back(child);
+        }
+    }
+
+    std::vector<NodeIndex> newIndices(count, NO_PARENT);
+    for (NodeIndex index = 0; index < order.size(); ++index) {
+        newIndices[order[index]] = index;
+    }
+
+    auto const reorder = [&order](auto& values) {
+        std::remove_reference_t<decltype(values)> result;
+        result.reserve(order.size());
+        for (auto const node : order) {
+            result.push_back(values[node]);
+        }
+        values = std::move(result);
+    };
+    reorder(nodeEntities);
+    reorder(parents);
+    reorder(localTransforms);
+    reorder(worldTransforms);
+    reorder(previousWorldTransforms);
+    reorder(worldActivities);
+    reorder(changes);
+    reorder(worldVersions);
+    reorder(outsideVersions);
+
+    subtreeSizes.assign(order.size(), 1u);
+    for (auto node = static_cast<NodeIndex>(order.size()); node-- > 0;) {
+        entityToNode.set(nodeEntities[node], node);
+
+        auto& parent = parents[node];
+        auto const newParent = parent != NO_PARENT && parent < count
+                                   ? newIndices[parent]
+                                   : NO_PARENT;
+        if (parent != NO_PARENT && newParent == NO_PARENT) {
+            changes[node] |= WORLD_TRANSFORM | ACTIVITY;
+        }
+        parent = newParent;
+    }
+    for (auto node = static_cast<NodeIndex>(order.size()); node-- > 0;) {
+        if (parents[node] != NO_PARENT) {
+            subtreeSizes[parents[node]] += subtreeSizes[node];
         }
     }
 }
 
-DirectX::XMMATRIX GraphSystem::matrix(Transform const& transform) {
-    // Convert rotation quaternion into axis-angle representation
-    dx::XMVECTOR quaternion =
-        dx::XMVectorSet(transform.rotation.x, transform.rotation.y,
-                        transform.rotation.z, transform.rotation.w);
+void GraphSystem::propagate() {
+    ++propagationVersion;
+
+    auto const count = static_cast<NodeIndex>(nodeEntities.size());
+    auto const batchSize = std::max(
+        MIN_BATCH_SIZE,
+        static_cast<NodeIndex>(
+            count / (JobSystem::instance().concurrency() * 4u)));
+
+    // Every batch ends at a root, so it holds whole subtrees only
+    size_t used = 0;
+    for (NodeIndex root = 0, begin = 0; root < count;) {
+        root += subtreeSizes[root];
+        if (root - begin >= batchSize || root == count) {
+            if (used == batches.size()) {
+                batches.emplace_back();
+            }
+            batches[used].begin = begin;
+            batches[used].end = root;
+            ++used;
+            begin = root;
+        }
+    }
+    batches.resize(used);
 
-    dx::XMVECTOR axis;
-    float angle;
-    dx::XMQuaternionToAxisAngle(&axis, &angle, quaternion);
+    JobSystem::instance().parallelFor(
+        batches.size(), [this](size_t const i) { propagate(batches[i]); }, 1u);
 
-    // Combine transformations
-    dx::XMMATRIX result = dx::XMMatrixIdentity();
+    // Toggle the activities of all changed nodes at once
+    for (auto& batch : batches) {
+        registry.tag<Active>(batch.activated, true);
+        registry.tag<Active>(batch.deactivated, false);
+        batch.activated.clear();
+        batch.deactivated.clear();
+    }
+}
 
-    // Scaling
-    result *= dx::XMMatrixScaling(transform.scale.x, transform.scale.y,
-                                  transform.scale.z);
-    // Rotation (Unity)
-    if (angle) {
-        result *= dx::XMMatrixRotationAxis(axis, angle);
+void GraphSystem::propagate(Batch& batch) {
+    // Compose the changed local transforms together, they don't depend on
+    // the parents
+    batch.transforms.clear();
+    batch.composed.clear();
+    for (auto node = batch.begin; node < batch.end; ++node) {
+        if (changes[node] & LOCAL_TRANSFORM) {
+            batch.transforms.add(
+                registry.peek<Transform>(nodeEntities[node]));
+            batch.composed.push_back(node);
+        }
+    }
+    batch.matrices.resize(batch.composed.size());
+    batch.transforms.compose(batch.matrices);
+    for (size_t i = 0; i < batch.composed.size(); ++i) {
+        localTransforms[batch.composed[i]] = batch.matrices[i];
     }
 
-    // Rotation (game)
-    result *= dx::XMMatrixRotationRollPitchYaw(
-        transform.euler.x, transform.euler.y, transform.euler.z);
+    // Update transformations and activities, the parents' changes are
+    // already complete when their children are reached
+    for (auto node = batch.begin; node < batch.end; ++node) {
+        auto const parent = parents[node];
+        if (parent != NO_PARENT) {
+            changes[node] |= changes[parent] & (WORLD_TRANSFORM | ACTIVITY);
+        }
 
-    // Translation
-    result *= dx::XMMatrixTranslation(
-        transform.position.x, transform.position.y, transform.position.z);
+        auto const change = changes[node];
+        if (!change) {
+            continue;
+        }
 
-    return result;
+        auto const entityId = nodeEntities[node];
+        if (change & WORLD_TRANSFORM) {
+            auto const world =
+                parent != NO_PARENT
+                    ? localTransforms[node] * worldTransforms[parent]
+                    : localTransforms[node];
+
+            // Keep the pose from before the steps, the new nodes have none
+            if (worldVersions[node] < stepBegin) {
+                previousWorldTransforms[node] =
+                    worldVersions[node] ? worldTransforms[node] : world;
+            }
+            worldTransforms[node] = world;
+            worldVersions[node] = propagationVersion;
+            if (!stepping) {
+                outsideVersions[node] = propagationVersion;
+            }
+        }
+        if (change & ACTIVITY) {
+            auto const activity =
+                registry.peek<Properties>(entityId).active &&
+                (parent == NO_PARENT || worldActivities[parent]);
+            worldActivities[node] = activity;
+
+            if (registry.hasComponent<Active>(entityId)) {
+                if (!activity) {
+                    batch.deactivated.push_back(entityId);
+                }
+            } else {
+                if (activity) {
+                    batch.activated.push_back(entityId);
+                }
+            }
+        }
+    }
+    std::fill(changes.begin() + batch.begin, changes.begin() + batch.end, 0u);
 }
 
 // ////////////////////////////////////////////////////////////////////////// //
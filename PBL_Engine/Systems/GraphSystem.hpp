@@ -4,10 +4,13 @@
 #include <DirectXMath.h>
 
 #include <Components/Transform.hpp>
+#include <cstdint>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
+#include "ECS/SparseIndex.hpp"
 #include "ECS/System.hpp"
+#include "TransformBatch.hpp"
 
 // /////////////////////////////////////////////////////////////////// System //
 ECS_SYSTEM(GraphSystem) {
@@ -21,27 +24,80 @@ ECS_SYSTEM(GraphSystem) {
 
     // ----------------------------------------------- Public interface -- == //
     DirectX::XMMATRIX transform(Entity const &entity);
+    // Changes whenever the world transform does, so everything computed
+    // from it can be cached until then
+    ChangeVersion worldVersion(Entity const &entity);
     void destroyEntityWithChildren(Entity const &entity);
 
+    // Adds the spawned entities to the graph, drops the destroyed ones and
+    // updates the transforms right away instead of on the next update
+    void refresh();
+
+    // Transforms changed by the last fixed step are returned blended between
+    // their poses before and after it, by the given fraction of the step,
+    // until the next one begins. The ones also changed outside the steps in
+    // the same frame, by the scripts, are returned as they are
+    void beginStep();
+    void interpolate(float fraction);
+    // Fraction the entity's transform is blended by, 1 when it's returned
+    // as it is. Whatever is cached for a world version depends on it too
+    float interpolation(Entity const &entity);
+
   private:
     // ========================================================= Behaviour == //
-    DirectX::XMMATRIX matrix(Transform const &transform);
+    struct Batch;
+
+    bool attach(std::vector<EntityId> const &entityIds);
+    void relayout();
+    void propagate();
+    void propagate(Batch &batch);
 
     // ============================================================== Data == //
-    struct GraphNode {
-        GraphNode *parent;
-        std::set<EntityId> children;
-
-        std::optional<Entity> entity;
-        Transform *transform;
-        bool *activity;
-        DirectX::XMMATRIX cumulativeTransform;
-        bool cumulativeActivity;
-        bool recalculateTransforms, recalculateActivity;
-    } root;
-    std::unordered_map<EntityId, GraphNode> entityToGraphNode;
-    std::unordered_map<EntityId, Transform> entityToPreviousTransform;
-    std::unordered_map<EntityId, bool> entityToPreviousActivity;
+    using NodeIndex = EntityId;
+    static constexpr NodeIndex NO_PARENT = EMPTY_ENTITY;
+
+    enum Change : std::uint8_t {
+        LOCAL_TRANSFORM = 1 << 0,
+        WORLD_TRANSFORM = 1 << 1,
+        ACTIVITY = 1 << 2,
+    };
+
+    // The nodes are stored depth-first, so every parent comes before its
+    // children and the world transforms are computed in one linear pass.
+    // Spawned subtrees are appended at the end, the nodes are reordered only
+    // when entities are destroyed or attached below the existing ones
+    std::vector<EntityId> nodeEntities;
+    std::vector<NodeIndex> parents;
+    std::vector<NodeIndex> subtreeSizes;
+    std::vector<DirectX::XMMATRIX> localTransforms, worldTransforms;
+    std::vector<DirectX::XMMATRIX> previousWorldTransforms;
+    std::vector<std::uint8_t> worldActivities, changes;
+    std::vector<ChangeVersion> worldVersions;
+    // Versions of the last changes made outside the fixed steps
+    std::vector<ChangeVersion> outsideVersions;
+    SparseIndex entityToNode;
+
+    // Subtrees of different roots don't depend on each other, so they're
+    // grouped into ranges of similar sizes propagated in parallel. The
+    // activity changes are collected per range and applied afterwards
+    struct Batch {
+        NodeIndex begin, end;
+        std::vector<EntityId> activated, deactivated;
+        TransformBatch transforms;
+        std::vector<NodeIndex> composed;
+        std::vector<DirectX::XMMATRIX> matrices;
+    };
+    static constexpr NodeIndex MIN_BATCH_SIZE = 256u;
+    std::vector<Batch> batches;
+
+    ChangeVersion transformVersion{0}, activityVersion{0};
+    ChangeVersion propagationVersion{0};
+
+    // Versions of the world transforms changed by the last fixed step, and
+    // the first one of the frame it was taken in
+    ChangeVersion stepBegin{1}, stepEnd{0}, frameBegin{1};
+    float stepFraction{1.0f};
+    bool stepping{false};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
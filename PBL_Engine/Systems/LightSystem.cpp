@@ -18,6 +18,9 @@
 void LightSystem::filters() {
     filter<Transform>();
     filter<Light>();
+
+    // The lights are bound with the device's immediate context, which only
+    // the main thread may use, so the access stays undeclared
 }
 
 void LightSystem::setup() {
@@ -42,7 +45,7 @@ void LightSystem::update(float deltaTime) {
         pointLight->AddToBuffer(DirectX::XMMatrixIdentity(),
                                 camera->GetCameraPos());
         pointLight->Bind(Registry::instance().system<WindowSystem>()->gfx());
-        if (entity.get<Properties>().name != "Player Torch") {
+        if (registry.peek<Properties>(entity.id).name != "Player Torch") {
             pointLight->setIntensity(
                 baseLightIntensity +
                 baseLightIntensity *
@@ -2,15 +2,24 @@
 #include "PhysicsSystem.hpp"
 
 // ECS
-#include "Components/Components.hpp"
+#include "Components/Rigidbody.hpp"
+#include "Components/Tags.hpp"
+#include "Components/Transform.hpp"
 #include "ECS/ECS.hpp"
 
 // /////////////////////////////////////////////////////////////////// System //
 // ============================================================= Behaviour == //
 
-void PhysicsSystem::filters() { filter<Active>().filter<Rigidbody>(); }
+void PhysicsSystem::filters() {
+    filter<Active>().filter<Rigidbody>();
+    write<Rigidbody>().write<Transform>();
+
+    // Gravity is applied to each body separately
+    entities.keepSorted(false);
+}
 
 void PhysicsSystem::setup() {
+    skippedSteps = 0;
     gravityFactor = 9.81f;
     secondsToAchieveMaxVelocity = 0.5f;
     maxVelocity = secondsToAchieveMaxVelocity * (-gravityFactor);
@@ -18,11 +27,9 @@ void PhysicsSystem::setup() {
 }
 
 void PhysicsSystem::update(float deltaTime) {
-    static int pom = 0;
-    if (pom++ < 10) {
+    if (skippedSteps < STEPS_TO_SKIP) {
+        ++skippedSteps;
         return;
-    } else {
-        pom = 100;
     }
     for (auto entity : entities) {
         gravity(entity, deltaTime);
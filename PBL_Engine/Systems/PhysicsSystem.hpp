@@ -24,6 +24,11 @@ ECS_SYSTEM(PhysicsSystem) {
     float maxVelocity;
     float secondsToAchieveMaxVelocity;
     float movementFactor;
+
+    // The first steps after setting up the scene don't move anything, the
+    // counter restarts with the next setup
+    static constexpr int STEPS_TO_SKIP = 10;
+    int skippedSteps{0};
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -11,6 +11,7 @@
 #include "Button.hpp"
 #include "FrustumCulling.h"
 #include "GDIPlusManager.h"
+#include "JobSystem.hpp"
 #include "Mesh.h"
 #include "PBLMath.h"
 #include "Text.h"
@@ -107,10 +108,21 @@ void RenderSystem::update(float deltaTime) {
     previousTripMode = tripMode;
 
     // Update AABB
-    for (Entity entity : entities) {
-        registry.system<ColliderSystem>()->CalculateAABB(
-            entity.get<AABB>(),
-            registry.system<GraphSystem>()->transform(entity));
+    auto const renderables =
+        registry.view<AABB, MeshFilter, Renderer, Transform, Active>();
+    auto const colliderSystem = registry.system<ColliderSystem>();
+    JobSystem::instance().parallelEach(
+        renderables, [&colliderSystem](Entity entity, AABB& aabb, auto&...) {
+            colliderSystem->RefreshAABB(aabb, entity);
+        });
+
+    boxes.clear();
+    for (auto const& entity : entities) {
+        auto const& aabb = entity.get<AABB>();
+        DirectX::XMFLOAT3 min, max;
+        DirectX::XMStoreFloat3(&min, aabb.vertexMin);
+        DirectX::XMStoreFloat3(&max, aabb.vertexMax);
+        boxes.add(min, max, entity.id);
     }
 
     // ----------------------------- SHADOW PASS --------------------------- //
@@ -136,28 +148,14 @@ void RenderSystem::update(float deltaTime) {
         auto frustum = CFrustum(viewProj);
 
         // Render all renderable models
-        for (auto const& entity : entities) {
-            auto div = DirectX::XMVectorSubtract(entity.get<AABB>().vertexMax,
-                                                 entity.get<AABB>().vertexMin);
-            auto avg = DirectX::XMVectorScale(div, 0.5f);
-
-            DirectX::XMFLOAT3 center;
-            DirectX::XMStoreFloat3(
-                &center,
-                DirectX::XMVectorAdd(avg, entity.get<AABB>().vertexMin));
-            DirectX::XMFLOAT3 radius;
-            DirectX::XMStoreFloat3(&radius, DirectX::XMVector3Length(avg));
-
-            if (frustum.SphereIntersection(center, radius.x)) {
-                auto& meshFilter = entity.get<MeshFilter>();
-                if (!entity.has<Refractive>()) {
-                    meshFilter.model->Draw(
-                        window->Gfx(),
-                        registry.system<GraphSystem>()->transform(entity),
-                        PassType::shadowPass);
-                }
+        boxes.eachInFrustum(frustum, [&](EntityId const entity) {
+            if (!registry.hasComponent<Refractive>(entity)) {
+                registry.peek<MeshFilter>(entity).model->Draw(
+                    window->Gfx(),
+                    registry.system<GraphSystem>()->transform(entity),
+                    PassType::shadowPass);
             }
-        }
+        });
     }
     shadowPass->End();
     shadowPass->shadowMap->Bind(window->Gfx());
@@ -225,31 +223,19 @@ void RenderSystem::update(float deltaTime) {
     auto frustum = CFrustum(viewProjection);
 
     // Render all renderable models
-    for (auto const& entity : entities) {
-        auto div = DirectX::XMVectorSubtract(entity.get<AABB>().vertexMax,
-                                             entity.get<AABB>().vertexMin);
-        auto avg = DirectX::XMVectorScale(div, 0.5f);
-
-        DirectX::XMFLOAT3 center;
-        DirectX::XMStoreFloat3(
-            &center, DirectX::XMVectorAdd(avg, entity.get<AABB>().vertexMin));
-        DirectX::XMFLOAT3 radius;
-        DirectX::XMStoreFloat3(&radius, DirectX::XMVector3Length(avg));
-
-        if (frustum.SphereIntersection(center, radius.x)) {
-            auto& meshFilter = entity.get<MeshFilter>();
-            if (entity.has<Refractive>() || tripMode) {
-                meshFilter.model->Draw(
-                    window->Gfx(),
-                    registry.system<GraphSystem>()->transform(entity),
-                    PassType::refractive);
-            } else {
-                meshFilter.model->Draw(
-                    window->Gfx(),
-                    registry.system<GraphSystem>()->transform(entity));
-            }
+    boxes.eachInFrustum(frustum, [&](EntityId const entity) {
+        auto const& meshFilter = registry.peek<MeshFilter>(entity);
+        if (registry.hasComponent<Refractive>(entity) || tripMode) {
+            meshFilter.model->Draw(
+                window->Gfx(),
+                registry.system<GraphSystem>()->transform(entity),
+                PassType::refractive);
+        } else {
+            meshFilter.model->Draw(
+                window->Gfx(),
+                registry.system<GraphSystem>()->transform(entity));
         }
-    }
+    });
 };
 
 void RenderSystem::release() {}
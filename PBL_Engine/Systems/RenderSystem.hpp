@@ -2,6 +2,7 @@
 
 // ///////////////////////////////////////////////////////////////// Includes //
 #include "Billboard.h"
+#include "BoxBatch.hpp"
 #include "Camera.h"
 #include "FireParticle.h"
 #include "ImguiManager.h"
@@ -39,6 +40,9 @@ ECS_SYSTEM(RenderSystem) {
     ImguiManager imgui;
     Transform *mainCameraTransform;
     bool (*isKeyPressed)(int const key);
+
+    // World boxes of the renderables, culled against every frustum at once
+    BoxBatch boxes;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
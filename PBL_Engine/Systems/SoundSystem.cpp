@@ -24,7 +24,10 @@ std::unordered_map<FileExtension, std::vector<Path>> audioPaths;
 // /////////////////////////////////////////////////////////////////// System //
 // ============================================================= Behaviour == //
 // ----------------------------------------- System's virtual functions -- == //
-void SoundSystem::filters() {}
+void SoundSystem::filters() {
+    // Only the audio engine is updated, which has its own locking
+    concurrent();
+}
 
 void SoundSystem::setup() {
     // Initialize the audio engine
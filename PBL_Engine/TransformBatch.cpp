@@ -0,0 +1,190 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "TransformBatch.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "Components/Transform.hpp"
+
+// /////////////////////////////////////////////////////////////// Namespaces //
+namespace dx = DirectX;
+
+// ////////////////////////////////////////////////////////////////// Helpers //
+namespace {
+// Rows of the rotation and scale part of the matrices, and the translation
+template <typename Value>
+struct Composed {
+    Value m00, m01, m02, m10, m11, m12, m20, m21, m22;
+    Value x, y, z;
+};
+
+void sinCos(float& sine, float& cosine, float const angle) {
+    sine = std::sin(angle);
+    cosine = std::cos(angle);
+}
+
+void sinCos(dx::XMVECTOR& sine, dx::XMVECTOR& cosine,
+            dx::FXMVECTOR const angles) {
+    dx::XMVectorSinCos(&sine, &cosine, angles);
+}
+
+float normalizing(float const lengthSquared) {
+    return lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+}
+
+dx::XMVECTOR normalizing(dx::FXMVECTOR const lengthsSquared) {
+    return dx::XMVectorSelect(
+        dx::XMVectorZero(), dx::XMVectorReciprocalSqrt(lengthsSquared),
+        dx::XMVectorGreater(lengthsSquared, dx::XMVectorZero()));
+}
+
+// The formulas of XMQuaternionNormalize, XMQuaternionRotationRollPitchYaw,
+// XMQuaternionMultiply and XMMatrixAffineTransformation without a rotation
+// origin, for single floats or for a lane of transforms each
+template <typename Value>
+Composed<Value> composeLanes(Value qx, Value qy, Value qz, Value qw,
+                             Value const pitch, Value const yaw,
+                             Value const roll, Value const scaleX,
+                             Value const scaleY, Value const scaleZ,
+                             Value const x, Value const y, Value const z,
+                             Value const one) {
+    auto const inverse = normalizing(qx * qx + qy * qy + qz * qz + qw * qw);
+    qx = qx * inverse;
+    qy = qy * inverse;
+    qz = qz * inverse;
+    qw = qw * inverse;
+
+    Value sp, cp, sy, cy, sr, cr;
+    sinCos(sp, cp, pitch * 0.5f);
+    sinCos(sy, cy, yaw * 0.5f);
+    sinCos(sr, cr, roll * 0.5f);
+    auto const ex = cr * sp * cy + sr * cp * sy;
+    auto const ey = cr * cp * sy - sr * sp * cy;
+    auto const ez = sr * cp * cy - cr * sp * sy;
+    auto const ew = cr * cp * cy + sr * sp * sy;
+
+    // The rotation of the quaternion followed by the one of the angles
+    auto const rx = ew * qx + ex * qw + ey * qz - ez * qy;
+    auto const ry = ew * qy - ex * qz + ey * qw + ez * qx;
+    auto const rz = ew * qz + ex * qy - ey * qx + ez * qw;
+    auto const rw = ew * qw - ex * qx - ey * qy - ez * qz;
+
+    auto const xx = rx * rx, yy = ry * ry, zz = rz * rz;
+    auto const xy = rx * ry, xz = rx * rz, yz = ry * rz;
+    auto const xw = rx * rw, yw = ry * rw, zw = rz * rw;
+    return {.m00 = scaleX * (one - (yy + zz) * 2.0f),
+            .m01 = scaleX * (xy + zw) * 2.0f,
+            .m02 = scaleX * (xz - yw) * 2.0f,
+            .m10 = scaleY * (xy - zw) * 2.0f,
+            .m11 = scaleY * (one - (xx + zz) * 2.0f),
+            .m12 = scaleY * (yz + xw) * 2.0f,
+            .m20 = scaleZ * (xz + yw) * 2.0f,
+            .m21 = scaleZ * (yz - xw) * 2.0f,
+            .m22 = scaleZ * (one - (xx + yy) * 2.0f),
+            .x = x,
+            .y = y,
+            .z = z};
+}
+
+dx::XMVECTOR lanes(std::vector<float> const& values, size_t const index) {
+    return dx::XMLoadFloat4(
+        reinterpret_cast<dx::XMFLOAT4 const*>(&values[index]));
+}
+}  // namespace
+
+// //////////////////////////////////////////////////////////////////// Class //
+// ============================================================= Behaviour == //
+void TransformBatch::clear() {
+    for (auto* values :
+         {&rotationX, &rotationY, &rotationZ, &rotationW, &eulerX, &eulerY,
+          &eulerZ, &scaleX, &scaleY, &scaleZ, &positionX, &positionY,
+          &positionZ}) {
+        values->clear();
+    }
+    count = 0;
+}
+
+void TransformBatch::add(Transform const& transform) {
+    auto const index = count++;
+    if (index % LANES == 0) {
+        for (auto* values :
+             {&rotationX, &rotationY, &rotationZ, &eulerX, &eulerY, &eulerZ,
+              &positionX, &positionY, &positionZ}) {
+            values->resize(index + LANES, 0.0f);
+        }
+        for (auto* values : {&rotationW, &scaleX, &scaleY, &scaleZ}) {
+            values->resize(index + LANES, 1.0f);
+        }
+    }
+
+    rotationX[index] = transform.rotation.x;
+    rotationY[index] = transform.rotation.y;
+    rotationZ[index] = transform.rotation.z;
+    rotationW[index] = transform.rotation.w;
+    eulerX[index] = transform.euler.x;
+    eulerY[index] = transform.euler.y;
+    eulerZ[index] = transform.euler.z;
+    scaleX[index] = transform.scale.x;
+    scaleY[index] = transform.scale.y;
+    scaleZ[index] = transform.scale.z;
+    positionX[index] = transform.position.x;
+    positionY[index] = transform.position.y;
+    positionZ[index] = transform.position.z;
+}
+
+void TransformBatch::compose(std::span<dx::XMMATRIX> const matrices) const {
+    assert(matrices.size() >= count && "Every transform needs a matrix!");
+
+    auto const zero = dx::XMVectorZero();
+    auto const ones = dx::XMVectorSplatOne();
+    for (size_t i = 0; i < count; i += LANES) {
+        auto const composed = composeLanes(
+            lanes(rotationX, i), lanes(rotationY, i), lanes(rotationZ, i),
+            lanes(rotationW, i), lanes(eulerX, i), lanes(eulerY, i),
+            lanes(eulerZ, i), lanes(scaleX, i), lanes(scaleY, i),
+            lanes(scaleZ, i), lanes(positionX, i), lanes(positionY, i),
+            lanes(positionZ, i), ones);
+
+        // Every vector holds one element of four matrices, transposing
+        // gathers the same row of all of them
+        auto const rows0 = dx::XMMatrixTranspose(
+            {composed.m00, composed.m01, composed.m02, zero});
+        auto const rows1 = dx::XMMatrixTranspose(
+            {composed.m10, composed.m11, composed.m12, zero});
+        auto const rows2 = dx::XMMatrixTranspose(
+            {composed.m20, composed.m21, composed.m22, zero});
+        auto const rows3 = dx::XMMatrixTranspose(
+            {composed.x, composed.y, composed.z, ones});
+
+        auto const used = std::min(LANES, count - i);
+        for (size_t lane = 0; lane < used; ++lane) {
+            matrices[i + lane] = {rows0.r[lane], rows1.r[lane],
+                                  rows2.r[lane], rows3.r[lane]};
+        }
+    }
+}
+
+void TransformBatch::composeScalar(
+    std::span<dx::XMFLOAT4X4> const matrices) const {
+    assert(matrices.size() >= count && "Every transform needs a matrix!");
+
+    for (size_t i = 0; i < count; ++i) {
+        auto const composed = composeLanes(
+            rotationX[i], rotationY[i], rotationZ[i], rotationW[i], eulerX[i],
+            eulerY[i], eulerZ[i], scaleX[i], scaleY[i], scaleZ[i],
+            positionX[i], positionY[i], positionZ[i], 1.0f);
+
+        auto& m = matrices[i].m;
+        m[0][0] = composed.m00, m[0][1] = composed.m01;
+        m[0][2] = composed.m02, m[0][3] = 0.0f;
+        m[1][0] = composed.m10, m[1][1] = composed.m11;
+        m[1][2] = composed.m12, m[1][3] = 0.0f;
+        m[2][0] = composed.m20, m[2][1] = composed.m21;
+        m[2][2] = composed.m22, m[2][3] = 0.0f;
+        m[3][0] = composed.x, m[3][1] = composed.y;
+        m[3][2] = composed.z, m[3][3] = 1.0f;
+    }
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
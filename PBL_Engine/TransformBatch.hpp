@@ -0,0 +1,47 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <span>
+#include <vector>
+
+#include "EngineAPI.hpp"
+
+// ///////////////////////////////////////////////////// Forward declarations //
+struct Transform;
+
+// //////////////////////////////////////////////////////////////////// Class //
+// Transforms stored as separate arrays of their components, so the local
+// matrices of a whole block of them are composed at once, one transform per
+// lane of the DirectXMath vectors
+class ENGINE_API TransformBatch {
+  public:
+    // ============================================================== Data == //
+    static constexpr size_t LANES = 4u;
+
+    // ========================================================= Behaviour == //
+    void clear();
+    void add(Transform const& transform);
+    size_t size() const { return count; }
+
+    // Scaling, the rotation of the quaternion followed by the one of the
+    // euler angles and translation, the same as multiplying their matrices.
+    // Writes one matrix per added transform, in order
+    void compose(std::span<DirectX::XMMATRIX> matrices) const;
+
+    // The same formulas on one transform at a time in plain floats, for the
+    // builds without DirectXMath's vector math
+    void composeScalar(std::span<DirectX::XMFLOAT4X4> matrices) const;
+
+  private:
+    // ============================================================== Data == //
+    // Padded to whole blocks with identity transforms
+    std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+    std::vector<float> eulerX, eulerY, eulerZ;
+    std::vector<float> scaleX, scaleY, scaleZ;
+    std::vector<float> positionX, positionY, positionZ;
+    size_t count{0};
+};
+
+// ////////////////////////////////////////////////////////////////////////// //
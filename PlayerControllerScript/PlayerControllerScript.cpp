@@ -80,9 +80,13 @@ PlayerControllerScript::PlayerControllerScript(Entity const& entity)
 // ----------------------------------------- System's virtual functions -- == //
 void PlayerControllerScript::setup() {
     // Set event listeners
-    registry.listen<OnCollisionEnter>(
+    listen<OnCollisionEnter>(
         MethodListener(PlayerControllerScript::onCollisionEnter));
-    registry.listen<OnGameStateChange>(
+    listen<OnCollisionStay>(
+        MethodListener(PlayerControllerScript::onCollisionStay));
+    listen<OnCollisionExit>(
+        MethodListener(PlayerControllerScript::onCollisionExit));
+    listen<OnGameStateChange>(
         MethodListener(PlayerControllerScript::onGameStateChange));
 
     // Set utility functors
@@ -495,43 +499,89 @@ void PlayerControllerScript::doGameLogic(float const deltaTime) {
     torchColor.x = std::lerp(torchColor.x + 0.5f, torchColor.x, lightValue);
     Entity(torch).get<Light>().pointLight->setColor(torchColor);
 
-    isGrounded = false;
+    isGrounded = !grounds.empty();
 };
 
 // ------------------------------------------------------------- Events -- == //
-void PlayerControllerScript::onCollisionEnter(OnCollisionEnter const& event) {
-    if (event.a.id == groundCheck || event.b.id == groundCheck) {
-        auto other =
-            Entity(event.a.id == groundCheck ? event.b.id : event.a.id);
+void PlayerControllerScript::onCollisionEnter(
+    std::span<OnCollisionEnter const> const events) {
+    for (auto const& event : events) {
+        if (event.a.id == entity.id || event.b.id == entity.id ||
+            event.a.id == groundCheck || event.b.id == groundCheck) {
+            handleCollision(event.a, event.b, event.minSeparatingVector, true);
+        }
+    }
+}
+
+void PlayerControllerScript::onCollisionStay(
+    std::span<OnCollisionStay const> const events) {
+    for (auto const& event : events) {
+        if (event.a.id == entity.id || event.b.id == entity.id ||
+            event.a.id == groundCheck || event.b.id == groundCheck) {
+            handleCollision(event.a, event.b, event.minSeparatingVector,
+                            false);
+        }
+    }
+}
+
+void PlayerControllerScript::onCollisionExit(
+    std::span<OnCollisionExit const> const events) {
+    // The other entity may be destroyed already, only its identifier is used
+    for (auto const& event : events) {
+        if (event.a.id == groundCheck || event.b.id == groundCheck) {
+            std::erase(grounds,
+                       event.a.id == groundCheck ? event.b.id : event.a.id);
+        }
+    }
+}
+
+// Pickups and deaths happen once when the contact begins, the ground check
+// and pushing out of the level geometry go on while it lasts
+void PlayerControllerScript::handleCollision(
+    Entity const& a, Entity const& b,
+    DirectX::XMFLOAT3 const& minSeparatingVector, bool const entered) {
+    if (a.id == groundCheck || b.id == groundCheck) {
+        auto other = Entity(a.id == groundCheck ? b.id : a.id);
         auto otherTag = other.get<Properties>().tag;
 
         if (other.id == entity.id) {
             return;
         } else if (otherTag == "Ground") {
             isGrounded |= true;
+            if (entered) {
+                grounds.push_back(other.id);
+            }
         }
     }
 
-    if (event.a.id == entity.id || event.b.id == entity.id) {
-        auto other = Entity(event.a.id == entity.id ? event.b.id : event.a.id);
+    if (a.id == entity.id || b.id == entity.id) {
+        auto other = Entity(a.id == entity.id ? b.id : a.id);
         auto otherTag = other.get<Properties>().tag;
 
         if (otherTag == "EnemySpawnPoint") {
             return;
         } else if (otherTag == "Torch") {
-            registry.system<GraphSystem>()->destroyEntityWithChildren(other);
-            resetTorchLight();
+            if (entered) {
+                registry.system<GraphSystem>()->destroyEntityWithChildren(
+                    other);
+                resetTorchLight();
+            }
         } else if (otherTag == "Trap") {
-            registry.system<GraphSystem>()->destroyEntityWithChildren(other);
-            canChangeForm = false;
+            if (entered) {
+                registry.system<GraphSystem>()->destroyEntityWithChildren(
+                    other);
+                canChangeForm = false;
+            }
         } else if (otherTag == "Waterfall") {
-            changeForm(humanForm);
-            if (!entity.has<Rigidbody>()) {
-                entity.add<Rigidbody>(rb);
+            if (entered) {
+                changeForm(humanForm);
+                if (!entity.has<Rigidbody>()) {
+                    entity.add<Rigidbody>(rb);
+                }
+                canChangeForm = false;
             }
-            canChangeForm = false;
         } else if (otherTag == "DeathCollider") {
-            if (currentState != RESULTS_TO_GAME_FADE_OUT) {
+            if (entered && currentState != RESULTS_TO_GAME_FADE_OUT) {
                 die();
             }
         } else if (otherTag == "Boundary") {
@@ -539,7 +589,7 @@ void PlayerControllerScript::onCollisionEnter(OnCollisionEnter const& event) {
         } else if (other.id == groundCheck) {
             return;
         } else if (otherTag == "Enemy" || otherTag == "Rook") {
-            if (currentState != RESULTS_TO_GAME_FADE_OUT) {
+            if (entered && currentState != RESULTS_TO_GAME_FADE_OUT) {
                 die();
             }
 
@@ -549,27 +599,18 @@ void PlayerControllerScript::onCollisionEnter(OnCollisionEnter const& event) {
 
             // StartCoroutine(waitToResetLvl());
         } else {
-            auto& boxCollider = entity.get<BoxCollider>();
-            boxCollider.separatingVectorSum += event.minSeparatingVector;
+            registry.system<ColliderSystem>()->Separate(entity, other);
 
-            if (std::abs(event.minSeparatingVector.x) > 0.0f) {
-                boxCollider.numberOfCollisions.x++;
-            }
-            if (std::abs(event.minSeparatingVector.y) > 0.0f) {
-                boxCollider.numberOfCollisions.y++;
-                if (entity.has<Rigidbody>()) {
-                    entity.get<Rigidbody>().velocity = 0.0f;
-                }
-            }
-            if (std::abs(event.minSeparatingVector.z) > 0.0f) {
-                boxCollider.numberOfCollisions.z++;
+            if (std::abs(minSeparatingVector.y) > 0.0f &&
+                entity.has<Rigidbody>()) {
+                entity.get<Rigidbody>().velocity = 0.0f;
             }
 
             // Possible solution to the adjacent box colliders problem
             // if (boxCollider.numberOfCollisions.x > 1 &&
-            //     event.minSeparatingVector.x > 0.0f) {
+            //     minSeparatingVector.x > 0.0f) {
             //     entity.get<Transform>().position.x +=
-            //         std::abs(event.minSeparatingVector.x) * 0.5f;
+            //         std::abs(minSeparatingVector.x) * 0.5f;
             // }
         }
     }
@@ -4,10 +4,14 @@
 #include <DirectXMath.h>
 
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "Components/Components.hpp"
 #include "ECS/Entity.hpp"
 #include "Events/OnCollisionEnter.hpp"
+#include "Events/OnCollisionExit.hpp"
+#include "Events/OnCollisionStay.hpp"
 #include "Events/OnGameStateChange.hpp"
 #include "PlayerControllerScriptAPI.hpp"
 #include "Script.hpp"
@@ -23,7 +27,12 @@ class PLAYERCONTROLLERSCRIPT_API PlayerControllerScript : public Script {
     void update(float const deltaTime) override;
 
     // --------------------------------------------------------- Events -- == //
-    void onCollisionEnter(OnCollisionEnter const &event);
+    void onCollisionEnter(std::span<OnCollisionEnter const> events);
+    void onCollisionStay(std::span<OnCollisionStay const> events);
+    void onCollisionExit(std::span<OnCollisionExit const> events);
+    void handleCollision(Entity const &a, Entity const &b,
+                         DirectX::XMFLOAT3 const &minSeparatingVector,
+                         bool entered);
     void onGameStateChange(OnGameStateChange const &event);
 
     // -------------------------------------------------------- Methods -- == //
@@ -91,6 +100,10 @@ class PLAYERCONTROLLERSCRIPT_API PlayerControllerScript : public Script {
     //    mainCamera;  // TODO: Add reference to the script? may not need
     float canChangeFormTimer = 0.0f;
     float canChangeFormCooldown = 2.0f;
+
+    // Collisions are checked in fixed steps, not every frame, so the ground
+    // touched by the ground check is remembered until the contact ends
+    std::vector<EntityId> grounds;
 };
 
 // ////////////////////////////////////////////////////////////////////////// //
@@ -52,9 +52,10 @@ TestScript::TestScript(Entity const& entity) : Script(entity){};
 
 // ----------------------------------------- System's virtual functions -- == //
 void TestScript::setup() {
-    registry.listen<OnCollisionEnter>(
+    listen<OnCollisionEnter>(
         MethodListener(TestScript::onCollisionEnter));
-    registry.listen<OnButtonClick>(MethodListener(TestScript::onButtonClick));
+    listen<OnCollisionStay>(MethodListener(TestScript::onCollisionStay));
+    listen<OnButtonClick>(MethodListener(TestScript::onButtonClick));
     isKeyPressed = [](int const key) {
         return registry.system<RenderSystem>()->window->keyboard.KeyIsPressed(
             key);
@@ -122,9 +123,17 @@ void TestScript::update(float const deltaTime) {
 
 // ------------------------------------------------------------- Events -- == //
 void TestScript::onCollisionEnter(OnCollisionEnter const& event) {
-    if (event.a.id == entity.id || event.b.id == entity.id) {
+    handleCollision(event.a, event.b);
+}
+
+void TestScript::onCollisionStay(OnCollisionStay const& event) {
+    handleCollision(event.a, event.b);
+}
+
+void TestScript::handleCollision(Entity const& a, Entity const& b) {
+    if (a.id == entity.id || b.id == entity.id) {
         auto& transform = entity.get<Transform>();
-        auto other = Entity(event.a.id == entity.id ? event.b.id : event.a.id);
+        auto other = Entity(a.id == entity.id ? b.id : a.id);
         auto& otherTransform = other.get<Transform>();
 
         if (isKeyPressed(VK_SHIFT)) {
@@ -6,6 +6,7 @@
 #include "ECS/Entity.hpp"
 #include "Events/OnButtonClick.hpp"
 #include "Events/OnCollisionEnter.hpp"
+#include "Events/OnCollisionStay.hpp"
 #include "Script.hpp"
 #include "TestScriptAPI.hpp"
 
@@ -21,6 +22,8 @@ class TESTSCRIPT_API TestScript : public Script {
 
     // --------------------------------------------------------- Events -- == //
     void onCollisionEnter(OnCollisionEnter const &event);
+    void onCollisionStay(OnCollisionStay const &event);
+    void handleCollision(Entity const &a, Entity const &b);
     void onButtonClick(OnButtonClick const &event);
 
     // -------------------------------------------------------- Methods -- == //
@@ -0,0 +1,53 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+// //////////////////////////////////////////////////////////////// Benchmark //
+// Benchmarks take --quick to run with small sizes as a part of the tests, so
+// they keep compiling and working between the measurements
+inline bool quick(int const argc, char** const argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Best time of the given number of runs in milliseconds, the other runs are
+// slowed down by the rest of the system
+template <typename Function>
+double measure(int const runs, Function&& function) {
+    auto best = std::numeric_limits<double>::max();
+    for (int run = 0; run < runs; ++run) {
+        auto const start = std::chrono::steady_clock::now();
+        function();
+        auto const end = std::chrono::steady_clock::now();
+        best = std::min(
+            best,
+            std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+inline void report(char const* const name, double const milliseconds,
+                   size_t const items) {
+    std::printf("%-48s %10.3f ms %10.2f ns/item\n", name, milliseconds,
+                milliseconds * 1e6 / static_cast<double>(items));
+}
+
+// Keeps the compiler from dropping the computations whose results aren't
+// used otherwise
+template <typename Type>
+void keep(Type const& value) {
+    static Type volatile sink;
+    sink = value;
+    static_cast<void>(sink);
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
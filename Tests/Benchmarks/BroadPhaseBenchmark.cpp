@@ -0,0 +1,155 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <numbers>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "BroadPhase.hpp"
+
+// //////////////////////////////////////////////////////////////////// Level //
+namespace {
+using Proxy = BroadPhase::Proxy;
+using Pair = BroadPhase::Pair;
+
+constexpr float CHUNK_LENGTH = 20.0f;
+constexpr int OBSTACLES_PER_CHUNK = 24;
+constexpr int ENEMIES_PER_CHUNK = 4;
+
+Proxy box(float const x, float const y, float const z, float const sizeX,
+          float const sizeY, float const sizeZ, bool const dynamic) {
+    return {.min = {x, y, z},
+            .max = {x + sizeX, y + sizeY, z + sizeZ},
+            .entityId = 0,
+            .dynamic = dynamic};
+}
+
+// Chunks laid out along X like the ones of the runner: a floor, two walls
+// along the sides and a few cross walls, obstacles spread over the floor and
+// the enemies walking between them, plus the player in the first chunk.
+// The dynamic ones sink a little into the floor, as they do under gravity
+std::vector<Proxy> spawnChunks(size_t const count) {
+    std::vector<Proxy> proxies;
+    for (size_t chunk = 0; chunk < count; ++chunk) {
+        auto const x = static_cast<float>(chunk) * CHUNK_LENGTH;
+        proxies.push_back(box(x, -1.0f, -5.0f, CHUNK_LENGTH, 1.0f, 10.0f,
+                              false));
+        proxies.push_back(box(x, 0.0f, -6.0f, CHUNK_LENGTH, 4.0f, 1.0f,
+                              false));
+        proxies.push_back(box(x, 0.0f, 5.0f, CHUNK_LENGTH, 4.0f, 1.0f,
+                              false));
+        for (int wall = 0; wall < 3; ++wall) {
+            proxies.push_back(box(x + 5.0f + wall * 5.0f, 0.0f,
+                                  wall % 2 ? -5.0f : 0.0f, 0.5f, 4.0f, 5.0f,
+                                  false));
+        }
+        for (int obstacle = 0; obstacle < OBSTACLES_PER_CHUNK; ++obstacle) {
+            proxies.push_back(box(x + 0.8f * obstacle,
+                                  0.0f, -4.5f + (obstacle * 7 % 9), 0.6f,
+                                  1.0f, 0.6f, false));
+        }
+        for (int enemy = 0; enemy < ENEMIES_PER_CHUNK; ++enemy) {
+            proxies.push_back(box(x + 2.0f + enemy * 4.5f, -0.05f,
+                                  -3.0f + enemy * 1.5f, 0.8f, 1.8f, 0.8f,
+                                  true));
+        }
+        if (chunk == 0) {
+            proxies.push_back(box(1.0f, -0.05f, 0.0f, 0.8f, 1.8f, 0.8f,
+                                  true));
+        }
+    }
+
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        proxies[i].entityId = static_cast<EntityId>(i);
+    }
+    return proxies;
+}
+
+// Walks the dynamic colliders back and forth a little every frame, back to
+// where they started every ten frames
+void move(std::vector<Proxy>& proxies, int const frame) {
+    auto const step =
+        0.2f * std::sin(0.2f * std::numbers::pi_v<float> *
+                        static_cast<float>(frame));
+    for (auto& proxy : proxies) {
+        if (proxy.dynamic) {
+            proxy.min.x += step;
+            proxy.max.x += step;
+        }
+    }
+}
+
+// The pairs as ColliderSystem found them before the broad phase: every
+// collider against every one with CheckCollisions, through a set
+void findAllPairs(std::vector<Proxy> const& proxies, std::vector<Pair>& pairs) {
+    std::set<std::pair<EntityId, EntityId>> candidates;
+    for (auto const& proxy : proxies) {
+        for (auto const& other : proxies) {
+            if (other.dynamic && proxy.entityId != other.entityId) {
+                candidates.insert(proxy.entityId < other.entityId
+                                      ? Pair{proxy.entityId, other.entityId}
+                                      : Pair{other.entityId, proxy.entityId});
+            }
+        }
+    }
+
+    for (auto const& [a, b] : candidates) {
+        auto const& boxA = proxies[a];
+        auto const& boxB = proxies[b];
+        if (boxA.max.x > boxB.min.x && boxA.min.x < boxB.max.x &&
+            boxA.max.y > boxB.min.y && boxA.min.y < boxB.max.y &&
+            boxA.max.z > boxB.min.z && boxA.min.z < boxB.max.z) {
+            pairs.emplace_back(a, b);
+        }
+    }
+}
+
+template <typename FindPairs>
+void run(char const* const name, int const runs, int const frames,
+         std::vector<Proxy> const& level, FindPairs&& findPairs) {
+    std::vector<Pair> pairs;
+    size_t found = 0;
+    auto const milliseconds = measure(runs, [&] {
+        auto proxies = level;
+        for (int frame = 0; frame < frames; ++frame) {
+            move(proxies, frame);
+            pairs.clear();
+            findPairs(proxies, pairs);
+        }
+        found = pairs.size();
+    });
+    report(name, milliseconds, level.size() * frames);
+    keep(found);
+    std::printf("    %zu pairs in the last frame\n", found);
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 5;
+    auto const frames = small ? 10 : 100;
+    auto const level = spawnChunks(small ? 4 : 50);
+    std::printf("%zu colliders\n", level.size());
+
+    run("every collider with every dynamic one", runs, frames / 10, level,
+        findAllPairs);
+
+    auto const broadPhase = [&](char const* const name,
+                                std::unique_ptr<BroadPhase> broadPhase) {
+        run(name, runs, frames, level,
+            [&](std::vector<Proxy> const& proxies, std::vector<Pair>& pairs) {
+                broadPhase->findPairs(proxies, pairs);
+            });
+    };
+    broadPhase("sweep and prune", std::make_unique<SweepAndPrune>());
+    broadPhase("spatial hash", std::make_unique<SpatialHash>());
+    broadPhase("spatial hash, 1 m cells", std::make_unique<SpatialHash>(1.0f));
+    broadPhase("dynamic tree", std::make_unique<DynamicTree>());
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
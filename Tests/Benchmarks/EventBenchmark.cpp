@@ -0,0 +1,139 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <any>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <random>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ECS/EventManager.hpp"
+#include "Events/OnCollisionEnter.hpp"
+
+// ////////////////////////////////////////////////////////////////// Legacy //
+// Listeners kept as std::any in a map by std::type_index, the way the
+// events were sent before they got identifiers
+class LegacyEventManager {
+  public:
+    template <typename EventType>
+    void listen(std::function<void(EventType const&)> const& listener) {
+        listeners[std::type_index(typeid(EventType))].push_back(listener);
+    }
+
+    template <typename EventType>
+    void send(EventType const& event) {
+        for (auto const& listener :
+             listeners[std::type_index(typeid(EventType))]) {
+            std::any_cast<std::function<void(EventType const&)>>(listener)(
+                event);
+        }
+    }
+
+  private:
+    std::unordered_map<std::type_index, std::list<std::any>> listeners;
+};
+
+// ////////////////////////////////////////////////////////////////// Script //
+// Counts the collisions of its entity, like the controller scripts do
+struct CollidingScript {
+    void onCollisionEnter(OnCollisionEnter const& event) {
+        if (event.a.id == entityId || event.b.id == entityId) {
+            ++collisions;
+        }
+    }
+
+    void onCollisionsEnter(std::span<OnCollisionEnter const> events) {
+        for (auto const& event : events) {
+            onCollisionEnter(event);
+        }
+    }
+
+    EntityId entityId;
+    size_t collisions{0};
+};
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 5;
+    auto const count = small ? size_t{10000} : size_t{1000000};
+
+    // The scripts of the player and of a few enemies
+    std::vector<CollidingScript> scripts(8);
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        scripts[i].entityId = static_cast<EntityId>(i);
+    }
+
+    std::vector<OnCollisionEnter> events;
+    std::mt19937 random{5};
+    for (size_t i = 0; i < count; ++i) {
+        events.push_back({Entity{static_cast<EntityId>(random() % 64)},
+                          Entity{static_cast<EntityId>(random() % 64)},
+                          {0.0f, 1.0f, 0.0f}});
+    }
+    std::printf("%zu events, %zu listeners\n", count, scripts.size());
+
+    LegacyEventManager legacyEventManager;
+    for (auto& script : scripts) {
+        legacyEventManager.listen<OnCollisionEnter>(
+            std::bind(&CollidingScript::onCollisionEnter, &script,
+                      std::placeholders::_1));
+    }
+    report("std::any and std::function",
+           measure(runs,
+                   [&] {
+                       for (auto const& event : events) {
+                           legacyEventManager.send(event);
+                       }
+                   }),
+           count);
+
+    auto& eventManager = EventManager::instance();
+    std::vector<ListenerId> listenerIds;
+    for (auto& script : scripts) {
+        listenerIds.push_back(eventManager.listen(
+            EventManager::method<&CollidingScript::onCollisionEnter>(
+                &script)));
+    }
+    report("EventManager::send",
+           measure(runs,
+                   [&] {
+                       for (auto const& event : events) {
+                           eventManager.send(event);
+                       }
+                   }),
+           count);
+    for (auto const listenerId : listenerIds) {
+        eventManager.unlisten(listenerId);
+    }
+
+    // Queued events reach batched listeners in one call per flush
+    listenerIds.clear();
+    for (auto& script : scripts) {
+        listenerIds.push_back(eventManager.listen(
+            EventManager::method<&CollidingScript::onCollisionsEnter>(
+                &script)));
+    }
+    eventManager.queue<OnCollisionEnter>();
+    report("EventManager::send queued, batched listeners",
+           measure(runs,
+                   [&] {
+                       for (auto const& event : events) {
+                           eventManager.send(event);
+                       }
+                       eventManager.flush<OnCollisionEnter>();
+                   }),
+           count);
+
+    size_t collisions = 0;
+    for (auto const& script : scripts) {
+        collisions += script.collisions;
+    }
+    keep(collisions);
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
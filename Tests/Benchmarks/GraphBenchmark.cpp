@@ -0,0 +1,101 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Components/Properties.hpp"
+#include "Components/Transform.hpp"
+#include "Systems/GraphSystem.hpp"
+#include "TestComponents.hpp"
+
+// //////////////////////////////////////////////////////////////////// Scene //
+namespace {
+auto& registry = Registry::instance();
+
+Entity spawn(std::optional<EntityId> const parent, float const x) {
+    auto entity = registry.createEntity();
+    entity.add<Properties>({"Node", "", true});
+    entity.add<Transform>({.parent = parent,
+                           .rotation = {0.0f, 0.0f, 0.0f, 1.0f},
+                           .position = {x, 0.0f, 0.0f},
+                           .scale = {1.0f, 1.0f, 1.0f},
+                           .euler = {0.0f, 0.1f, 0.0f},
+                           .root_Order = 0});
+    return entity;
+}
+
+// Chunks of nine objects made of ten parts each, 100 nodes per chunk
+std::vector<EntityId> spawnChunks(size_t const count) {
+    std::vector<EntityId> roots;
+    for (size_t chunk = 0; chunk < count; ++chunk) {
+        auto const root = spawn(std::nullopt, static_cast<float>(chunk));
+        roots.push_back(root.id);
+        for (int object = 0; object < 9; ++object) {
+            auto const child = spawn(root.id, 1.0f);
+            for (int part = 0; part < 10; ++part) {
+                spawn(child.id, 0.1f);
+            }
+        }
+    }
+    return roots;
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    registerTestComponents();
+    ECS_REGISTER_COMPONENT(Properties);
+    ECS_REGISTER_COMPONENT(Transform);
+    SystemManager::instance().registerSystemType<GraphSystem>();
+    auto const graphSystem = registry.system<GraphSystem>();
+
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 10;
+    auto const frames = small ? 2 : 100;
+    auto const roots = spawnChunks(small ? 10 : 100);
+    auto const nodes = graphSystem->entities.size();
+    std::printf("%zu nodes\n", nodes);
+
+    report("setup, every node", measure(runs, [&] { graphSystem->setup(); }),
+           nodes);
+    report("refresh, nothing changed",
+           measure(runs,
+                   [&] {
+                       for (int frame = 0; frame < frames; ++frame) {
+                           graphSystem->refresh();
+                       }
+                   }),
+           nodes * frames);
+
+    // One chunk moving, like the ones with moving traps
+    report("refresh, one chunk moved",
+           measure(runs,
+                   [&] {
+                       for (int frame = 0; frame < frames; ++frame) {
+                           Entity{roots.front()}
+                               .get<Transform>()
+                               .position.y += 0.01f;
+                           graphSystem->refresh();
+                       }
+                   }),
+           nodes * frames);
+
+    report("refresh, every root moved",
+           measure(runs,
+                   [&] {
+                       for (int frame = 0; frame < frames; ++frame) {
+                           for (auto const root : roots) {
+                               Entity{root}.get<Transform>().position.y +=
+                                   0.01f;
+                           }
+                           graphSystem->refresh();
+                       }
+                   }),
+           nodes * frames);
+
+    keep(DirectX::XMVectorGetX(
+        graphSystem->transform(Entity{roots.back()}).r[3]));
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,124 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "TestComponents.hpp"
+
+// /////////////////////////////////////////////////////////////////// System //
+// Moves the entities the way the engine's systems access their components,
+// one entity at a time through the set of matched entities
+ECS_SYSTEM(MovementSystem) {
+  public:
+    void filters() override {
+        filter<Position>().filter<Velocity>().filter<Active>();
+    }
+    void setup() override {}
+    void update(float const deltaTime) override {
+        for (auto entity : entities) {
+            auto& position = entity.get<Position>();
+            auto const& velocity = entity.get<Velocity>();
+            position.x += velocity.x * deltaTime;
+            position.y += velocity.y * deltaTime;
+            position.z += velocity.z * deltaTime;
+        }
+    }
+    void release() override {}
+};
+
+// //////////////////////////////////////////////////////////////////// Scene //
+namespace {
+auto& registry = Registry::instance();
+
+// Entities of a few chunks with mixed signatures. The components are added
+// in a shuffled order, like the ones of spawned and destroyed chunks, so the
+// arrays of different types don't follow the same order of entities
+std::vector<EntityId> spawn(size_t const count) {
+    std::vector<EntityId> entityIds;
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = registry.createEntity();
+        entity.add<Position>({static_cast<float>(i), 0.0f, 0.0f});
+        entityIds.push_back(entity.id);
+    }
+
+    auto shuffled = entityIds;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{7});
+    for (size_t i = 0; i < shuffled.size(); ++i) {
+        Entity entity = shuffled[i];
+        if (i % 4 != 0) {
+            entity.add<Velocity>({1.0f, 0.5f, 0.25f});
+        }
+        if (i % 2 == 0) {
+            entity.add<Bounds>({});
+        }
+        if (i % 5 != 0) {
+            entity.add<Active>({});
+        }
+    }
+    return entityIds;
+}
+
+void destroy(std::vector<EntityId> const& entityIds) {
+    for (auto const entityId : entityIds) {
+        registry.destroyEntity(entityId);
+    }
+    registry.refresh();
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    registerTestComponents();
+    SystemManager::instance().registerSystemType<MovementSystem>();
+    auto const movementSystem = registry.system<MovementSystem>();
+
+#ifdef ECS_ARCHETYPE_STORAGE
+    std::printf("Storage: archetypes\n");
+#else
+    std::printf("Storage: component arrays\n");
+#endif
+
+    // A chunk and a few dozens of them
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 10;
+    auto const frames = small ? 2 : 100;
+    auto const counts = small ? std::vector<size_t>{2000}
+                              : std::vector<size_t>{2000, 40000};
+    for (auto const count : counts) {
+        auto const entityIds = spawn(count);
+        std::printf("%zu entities, %zu moving\n", count,
+                    movementSystem->entities.size());
+
+        auto const items = movementSystem->entities.size() * frames;
+        report("view<Position, Velocity, Active>",
+               measure(runs,
+                       [&] {
+                           for (int frame = 0; frame < frames; ++frame) {
+                               registry.view<Position, Velocity, Active>()
+                                   .each([](EntityId, Position& position,
+                                            Velocity const& velocity,
+                                            Active&) {
+                                       position.x += velocity.x * 0.016f;
+                                       position.y += velocity.y * 0.016f;
+                                       position.z += velocity.z * 0.016f;
+                                   });
+                           }
+                       }),
+               items);
+        report("System::entities and Entity::get",
+               measure(runs,
+                       [&] {
+                           for (int frame = 0; frame < frames; ++frame) {
+                               movementSystem->update(0.016f);
+                           }
+                       }),
+               items);
+
+        destroy(entityIds);
+    }
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
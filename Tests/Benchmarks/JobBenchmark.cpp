@@ -0,0 +1,51 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "JobSystem.hpp"
+
+// ///////////////////////////////////////////////////////////////////// Main //
+// Runs the same parallelFor with one thread up to all of them, the work per
+// index is about the one of composing a transform
+int main(int argc, char** argv) {
+    auto& jobSystem = JobSystem::instance();
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 10;
+    auto const count = small ? size_t{10000} : size_t{1000000};
+    auto const threads = jobSystem.concurrency();
+
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(i);
+    }
+    std::printf("%zu items, up to %zu threads\n", count, threads);
+
+    auto const work = [&values](size_t const i) {
+        auto value = values[i];
+        for (int step = 0; step < 16; ++step) {
+            value = std::sqrt(value * value + 1.0f) * 0.999f;
+        }
+        values[i] = value;
+    };
+
+    double single = 0.0;
+    for (size_t used = 1; used <= threads; ++used) {
+        jobSystem.limit(used);
+        auto const milliseconds =
+            measure(runs, [&] { jobSystem.parallelFor(count, work); });
+        single = used == 1 ? milliseconds : single;
+
+        char name[48];
+        std::snprintf(name, sizeof(name), "parallelFor, %zu threads, %.2fx",
+                      used, single / milliseconds);
+        report(name, milliseconds, count);
+    }
+    jobSystem.limit(0);
+
+    keep(values[count / 2]);
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
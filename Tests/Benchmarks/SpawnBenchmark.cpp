@@ -0,0 +1,108 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "TestComponents.hpp"
+
+// ////////////////////////////////////////////////////////////////// Systems //
+// Systems of the scene, the moving entities are matched by one of them
+ECS_SYSTEM(MovementSystem) {
+  public:
+    void filters() override {
+        filter<Position>().filter<Velocity>().filter<Active>();
+    }
+    void setup() override {}
+    void update(float) override {}
+    void release() override {}
+};
+
+// The other systems of the engine filter by components which the spawned
+// entities don't have, half of them by one the entities do have as well
+template <int Index>
+struct OtherSystem : public System,
+                     public SystemWrapper<OtherSystem<Index>>,
+                     public SystemRegistrant<OtherSystem<Index>> {
+    void filters() override {
+        if constexpr (Index % 2 == 0) {
+            this->template filter<Refractive>();
+        } else {
+            this->template filter<Position>()
+                .template filter<CheckCollisions>();
+        }
+    }
+    void setup() override {}
+    void update(float) override {}
+    void release() override {}
+};
+
+template <int... Indices>
+void registerOtherSystems(std::integer_sequence<int, Indices...>) {
+    auto& systemManager = SystemManager::instance();
+    (systemManager.registerSystemType<OtherSystem<Indices>>(), ...);
+}
+
+// //////////////////////////////////////////////////////////////////// Scene //
+namespace {
+auto& registry = Registry::instance();
+
+// Spawns the entities one component at a time, like the prefabs of a chunk
+// are loaded, and destroys them again
+void spawn(std::vector<EntityId>& entityIds, size_t const count) {
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = registry.createEntity();
+        entity.add<Position>({static_cast<float>(i), 0.0f, 0.0f});
+        entity.add<Velocity>({1.0f, 0.0f, 0.0f});
+        entity.add<Bounds>({});
+        entity.add<Active>({});
+        entityIds.push_back(entity.id);
+    }
+}
+
+void destroy(std::vector<EntityId>& entityIds) {
+    for (auto const entityId : entityIds) {
+        registry.destroyEntity(entityId);
+    }
+    registry.refresh();
+    entityIds.clear();
+}
+
+void measureSpawning(int const runs, size_t const count) {
+    std::vector<EntityId> entityIds;
+    auto spawning = std::numeric_limits<double>::max();
+    auto destroying = std::numeric_limits<double>::max();
+    for (int run = 0; run < runs; ++run) {
+        spawning = std::min(spawning,
+                            measure(1, [&] { spawn(entityIds, count); }));
+        destroying =
+            std::min(destroying, measure(1, [&] { destroy(entityIds); }));
+    }
+    report("spawn, four components each", spawning, count);
+    report("destroy and refresh", destroying, count);
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    registerTestComponents();
+    SystemManager::instance().registerSystemType<MovementSystem>();
+
+    auto const small = quick(argc, argv);
+    auto const runs = small ? 1 : 10;
+    auto const count = small ? size_t{2000} : size_t{50000};
+
+    // Bucketing the systems by component keeps the cost of a structural
+    // change independent of the systems which don't care about it
+    std::printf("%zu entities, 1 system\n", count);
+    measureSpawning(runs, count);
+
+    registerOtherSystems(std::make_integer_sequence<int, 24>{});
+    std::printf("%zu entities, 25 systems\n", count);
+    measureSpawning(runs, count);
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,80 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cstdio>
+
+#include "Benchmark.hpp"
+#include "TestComponents.hpp"
+
+// /////////////////////////////////////////////////////////////////// System //
+// Computes the centers of the boxes the way RenderSystem did before views,
+// getting the same component several times per entity
+ECS_SYSTEM(CullingSystem) {
+  public:
+    void filters() override {
+        filter<Bounds>().filter<Position>().filter<Active>();
+    }
+    void setup() override {}
+    void update(float const deltaTime) override {
+        for (auto entity : entities) {
+            auto const x = (entity.get<Bounds>().max[0] -
+                            entity.get<Bounds>().min[0]) *
+                               0.5f +
+                           entity.get<Bounds>().min[0];
+            entity.get<Position>().x = x + deltaTime;
+        }
+    }
+    void release() override {}
+};
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main(int argc, char** argv) {
+    registerTestComponents();
+    SystemManager::instance().registerSystemType<CullingSystem>();
+    auto& registry = Registry::instance();
+    auto const cullingSystem = registry.system<CullingSystem>();
+
+    // Chunk-sized scene, some entities are inactive or have no bounds
+    auto const small = quick(argc, argv);
+    auto const count = small ? 2000 : 20000;
+    for (int i = 0; i < count; ++i) {
+        auto entity = registry.createEntity();
+        entity.add<Position>({});
+        if (i % 3 != 0) {
+            entity.add<Bounds>({{0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}});
+        }
+        if (i % 7 != 0) {
+            entity.add<Active>({});
+        }
+    }
+
+    auto const runs = small ? 1 : 10;
+    auto const frames = small ? 2 : 100;
+    auto const items = cullingSystem->entities.size() * frames;
+    std::printf("%d entities, %zu culled\n", count,
+                cullingSystem->entities.size());
+
+    report("System::entities, Entity::get four times",
+           measure(runs,
+                   [&] {
+                       for (int frame = 0; frame < frames; ++frame) {
+                           cullingSystem->update(0.016f);
+                       }
+                   }),
+           items);
+    report("view<Bounds, Position, Active>",
+           measure(runs,
+                   [&] {
+                       for (int frame = 0; frame < frames; ++frame) {
+                           for (auto [entityId, bounds, position, active] :
+                                registry.view<Bounds, Position, Active>()) {
+                               auto const x =
+                                   (bounds.max[0] - bounds.min[0]) * 0.5f +
+                                   bounds.min[0];
+                               position.x = x + 0.016f;
+                           }
+                       }
+                   }),
+           items);
+    return 0;
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
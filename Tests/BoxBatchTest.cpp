@@ -0,0 +1,181 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "BoxBatch.hpp"
+#include "Check.hpp"
+#include "FrustumCulling.h"
+
+// /////////////////////////////////////////////////////////////// Namespaces //
+namespace dx = DirectX;
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+struct Box {
+    dx::XMFLOAT3 min, max;
+};
+
+// Boxes of different sizes around the origin, some of them touching the
+// others exactly, for the strict comparisons
+std::vector<Box> randomBoxes(size_t const count) {
+    std::mt19937 random(11u);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> size(0.1f, 8.0f);
+
+    std::vector<Box> boxes;
+    for (size_t i = 0; i < count; ++i) {
+        dx::XMFLOAT3 const min{position(random), position(random),
+                               position(random)};
+        boxes.push_back(
+            {min, {min.x + size(random), min.y + size(random),
+                   min.z + size(random)}});
+        if (i % 7 == 6) {
+            auto& box = boxes.back();
+            auto const shift = boxes[i - 1].max.x - box.min.x;
+            box.min.x += shift;
+            box.max.x += shift;
+        }
+    }
+    return boxes;
+}
+
+bool overlap(Box const& a, Box const& b) {
+    return a.max.x > b.min.x && a.min.x < b.max.x && a.max.y > b.min.y &&
+           a.min.y < b.max.y && a.max.z > b.min.z && a.min.z < b.max.z;
+}
+
+// The corner farthest along the normal of every plane has to be in front
+// of it
+bool inFrustum(CFrustum const& frustum, Box const& box) {
+    for (auto const& plane : frustum.p) {
+        auto const x = plane.normal.x >= 0.0f ? box.max.x : box.min.x;
+        auto const y = plane.normal.y >= 0.0f ? box.max.y : box.min.y;
+        auto const z = plane.normal.z >= 0.0f ? box.max.z : box.min.z;
+        if (plane.normal.x * x + plane.normal.y * y + plane.normal.z * z +
+                plane.d <=
+            0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BoxBatch batchOf(std::vector<Box> const& boxes) {
+    BoxBatch batch;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        batch.add(boxes[i].min, boxes[i].max, static_cast<EntityId>(i));
+    }
+    return batch;
+}
+
+// Every box of the batch against every other one, also when the last block
+// isn't full
+void overlapsLikeScalar(size_t const count) {
+    auto const boxes = randomBoxes(count);
+    auto batch = batchOf(boxes);
+
+    auto mismatches = 0;
+    for (auto const& box : boxes) {
+        std::vector<bool> found(boxes.size(), false);
+        batch.eachOverlapping(box.min, box.max, [&](EntityId const entity) {
+            found[entity] = true;
+        });
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            mismatches += found[i] != overlap(box, boxes[i]) ? 1 : 0;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Only the boxes in the range are visited, with their indices
+void overlapsInRange() {
+    auto const boxes = randomBoxes(23);
+    auto batch = batchOf(boxes);
+    Box const everything{{-100.0f, -100.0f, -100.0f},
+                         {100.0f, 100.0f, 100.0f}};
+
+    auto mismatches = 0;
+    for (size_t first = 0; first <= boxes.size(); ++first) {
+        for (size_t last = first; last <= boxes.size(); ++last) {
+            size_t expected = first, visits = 0;
+            batch.eachOverlapping(
+                everything.min, everything.max, first, last,
+                [&](EntityId const entity, size_t const index) {
+                    mismatches += index != expected++ ? 1 : 0;
+                    mismatches += entity != index ? 1 : 0;
+                    ++visits;
+                });
+            mismatches += visits != last - first ? 1 : 0;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Frustums of a perspective camera looking along every axis, the boxes are
+// culled as boxes, tighter than the spheres around them used before
+void culledLikeScalar() {
+    auto const boxes = randomBoxes(1001);
+    auto batch = batchOf(boxes);
+
+    auto const projection =
+        dx::XMMatrixPerspectiveFovLH(1.2f, 16.0f / 9.0f, 0.1f, 30.0f);
+    dx::XMVECTOR const directions[] = {
+        dx::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f),
+        dx::XMVectorSet(-1.0f, 0.0f, 0.0f, 0.0f),
+        dx::XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+        dx::XMVectorSet(0.0f, 0.0f, -1.0f, 0.0f),
+        dx::XMVectorSet(0.3f, 0.2f, 1.0f, 0.0f),
+    };
+
+    auto mismatches = 0, visible = 0, looser = 0;
+    for (auto const direction : directions) {
+        dx::XMFLOAT4X4 viewProjection;
+        dx::XMStoreFloat4x4(
+            &viewProjection,
+            dx::XMMatrixLookToLH(dx::XMVectorSet(2.0f, 1.0f, 0.0f, 1.0f),
+                                 direction,
+                                 dx::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) *
+                projection);
+        CFrustum frustum(viewProjection);
+
+        std::vector<bool> found(boxes.size(), false);
+        batch.eachInFrustum(frustum, [&](EntityId const entity) {
+            found[entity] = true;
+        });
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            mismatches += found[i] != inFrustum(frustum, boxes[i]) ? 1 : 0;
+            visible += found[i] ? 1 : 0;
+
+            // Nothing culled by the spheres may be drawn
+            auto const& box = boxes[i];
+            dx::XMFLOAT3 const center{(box.min.x + box.max.x) / 2.0f,
+                                      (box.min.y + box.max.y) / 2.0f,
+                                      (box.min.z + box.max.z) / 2.0f};
+            auto const radius = std::sqrt(
+                (box.max.x - center.x) * (box.max.x - center.x) +
+                (box.max.y - center.y) * (box.max.y - center.y) +
+                (box.max.z - center.z) * (box.max.z - center.z));
+            auto const sphere = frustum.SphereIntersection(center, radius);
+            mismatches += found[i] && !sphere ? 1 : 0;
+            looser += !found[i] && sphere ? 1 : 0;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(visible > 0);
+    CHECK(looser > 0);
+}
+}  // namespace
+
+int main() {
+    overlapsLikeScalar(1);
+    overlapsLikeScalar(4);
+    overlapsLikeScalar(301);
+    overlapsInRange();
+    culledLikeScalar();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
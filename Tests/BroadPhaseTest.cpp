@@ -0,0 +1,134 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BroadPhase.hpp"
+#include "Check.hpp"
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+using Proxy = BroadPhase::Proxy;
+using Pair = BroadPhase::Pair;
+
+// Small dynamic and static boxes, with a few long ones like the floors and
+// walls, spanning too many cells of the spatial hash. Some share their
+// bounds on X exactly
+std::vector<Proxy> randomProxies(size_t const count) {
+    std::mt19937 random(5u);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.2f, 3.0f);
+
+    std::vector<Proxy> proxies;
+    for (size_t i = 0; i < count; ++i) {
+        auto& proxy = proxies.emplace_back();
+        proxy.min = {position(random), position(random) / 10.0f,
+                     position(random) / 10.0f};
+        auto const length = i % 37 == 0 ? 60.0f : size(random);
+        proxy.max = {proxy.min.x + length, proxy.min.y + size(random),
+                     proxy.min.z + size(random)};
+        if (i % 11 == 10) {
+            auto const shift = proxies[i - 1].min.x - proxy.min.x;
+            proxy.min.x += shift;
+            proxy.max.x += shift;
+        }
+        proxy.entityId = static_cast<EntityId>(i);
+        proxy.dynamic = i % 3 == 0;
+        proxy.layers = i % 13 == 0 ? 2u : 1u;
+        proxy.mask = i % 17 == 0 ? 1u : ~0u;
+    }
+    return proxies;
+}
+
+std::vector<Pair> allPairs(std::vector<Proxy> const& proxies) {
+    std::vector<Pair> pairs;
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        for (size_t j = i + 1; j < proxies.size(); ++j) {
+            auto const& a = proxies[i];
+            auto const& b = proxies[j];
+            if ((a.dynamic || b.dynamic) && (a.layers & b.mask) &&
+                (b.layers & a.mask) && a.max.x > b.min.x &&
+                a.min.x < b.max.x && a.max.y > b.min.y && a.min.y < b.max.y &&
+                a.max.z > b.min.z && a.min.z < b.max.z) {
+                pairs.emplace_back(a.entityId, b.entityId);
+            }
+        }
+    }
+    return pairs;
+}
+
+// Every pair is found once, over frames of the dynamic boxes moving
+void findsAllPairs(BroadPhase& broadPhase) {
+    auto proxies = randomProxies(700);
+    auto mismatches = 0;
+    size_t found = 0;
+    for (int frame = 0; frame < 4; ++frame) {
+        std::vector<Pair> pairs;
+        broadPhase.findPairs(proxies, pairs);
+        std::sort(pairs.begin(), pairs.end());
+        mismatches += pairs != allPairs(proxies) ? 1 : 0;
+        found += pairs.size();
+
+        for (auto& proxy : proxies) {
+            if (proxy.dynamic) {
+                proxy.min.x += 0.7f;
+                proxy.max.x += 0.7f;
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(found > 0);
+}
+
+// The layers ignored by the matrix don't pair up, both ways and on the
+// same layer, the others still do
+void skipsIgnoredLayers(BroadPhase& broadPhase) {
+    LayerMatrix matrix;
+    matrix.ignore(1u, 2u);
+    matrix.ignore(3u, 3u);
+    CHECK(matrix.mask(1u) == ~(1u << 2u));
+    CHECK(matrix.mask(2u) == ~(1u << 1u));
+    CHECK(matrix.mask(0u) == ~0u);
+
+    auto proxies = randomProxies(700);
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        auto const layer = static_cast<unsigned int>(i % 4);
+        proxies[i].layers = 1u << layer;
+        proxies[i].mask = matrix.mask(layer);
+    }
+
+    std::vector<Pair> pairs;
+    broadPhase.findPairs(proxies, pairs);
+    std::sort(pairs.begin(), pairs.end());
+    CHECK(pairs == allPairs(proxies));
+
+    auto ignored = 0, kept = 0;
+    for (auto const& [a, b] : pairs) {
+        auto const aLayer = a % 4, bLayer = b % 4;
+        ignored += (aLayer == 1 && bLayer == 2) ||
+                           (aLayer == 2 && bLayer == 1) ||
+                           (aLayer == 3 && bLayer == 3)
+                       ? 1
+                       : 0;
+        kept += aLayer != bLayer ? 1 : 0;
+    }
+    CHECK(ignored == 0);
+    CHECK(kept > 0);
+}
+}  // namespace
+
+int main() {
+    SweepAndPrune sweepAndPrune;
+    findsAllPairs(sweepAndPrune);
+    skipsIgnoredLayers(sweepAndPrune);
+    SpatialHash spatialHash;
+    findsAllPairs(spatialHash);
+    skipsIgnoredLayers(spatialHash);
+    DynamicTree dynamicTree;
+    findsAllPairs(dynamicTree);
+    skipsIgnoredLayers(dynamicTree);
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,23 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <cstdio>
+
+// //////////////////////////////////////////////////////////////////// Check //
+// Tests report every failed check and return the number of failures from
+// main, so ctest shows all of them at once
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(condition)                                                    \
+    do {                                                                    \
+        if (!(condition)) {                                                 \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,    \
+                        #condition);                                        \
+            ++failures();                                                   \
+        }                                                                   \
+    } while (false)
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,100 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <vector>
+
+#include "Check.hpp"
+#include "TestComponents.hpp"
+
+// ///////////////////////////////////////////////////////////////// Helpers //
+namespace {
+auto& registry = Registry::instance();
+
+// ///////////////////////////////////////////////////////////////// System //
+ECS_SYSTEM(MovingSystem) {
+  public:
+    void filters() override { filter<Position>().filter<Velocity>(); }
+    void setup() override {}
+    void update(float) override {}
+    void release() override {}
+};
+
+// /////////////////////////////////////////////////////////////////// Tests //
+// Nothing changes until the commands are applied, then the entities have
+// the components with the recorded values and join the systems
+void addsWhenApplied() {
+    auto const system = registry.system<MovingSystem>();
+    std::vector<EntityId> entityIds;
+    for (int i = 0; i < 10; ++i) {
+        auto const entityId = registry.createEntity().id;
+        entityIds.push_back(entityId);
+        registry.commands().add<Position>(
+            entityId, {static_cast<float>(i), 0.0f, 0.0f});
+    }
+    // Recorded out of the order of the entities
+    for (auto it = entityIds.rbegin(); it != entityIds.rend(); ++it) {
+        registry.commands().add<Velocity>(*it, {1.0f, 0.0f, 0.0f});
+    }
+
+    auto early = 0;
+    for (auto const entityId : entityIds) {
+        early += Entity(entityId).has<Position>() ? 1 : 0;
+        early += system->entities.contains(entityId) ? 1 : 0;
+    }
+    CHECK(early == 0);
+    CHECK(!registry.commands().empty());
+
+    registry.applyCommands();
+    CHECK(registry.commands().empty());
+    auto mismatches = 0;
+    for (size_t i = 0; i < entityIds.size(); ++i) {
+        Entity const entity(entityIds[i]);
+        mismatches += entity.get<Position>().x != static_cast<float>(i);
+        mismatches += entity.get<Velocity>().x != 1.0f;
+        mismatches += !system->entities.contains(entity.id);
+    }
+    CHECK(mismatches == 0);
+
+    for (auto const entityId : entityIds) {
+        registry.destroyEntity(Entity(entityId));
+    }
+    registry.refresh();
+}
+
+// One entity's commands are replayed in the order they were recorded, only
+// its final signature reaches the systems
+void appliesInOrder() {
+    auto const system = registry.system<MovingSystem>();
+    auto const removed = registry.createEntity().id;
+    auto const kept = registry.createEntity().id;
+    for (auto const entityId : {removed, kept}) {
+        registry.commands().add<Position>(entityId, {1.0f, 2.0f, 3.0f});
+        registry.commands().add<Velocity>(entityId, {0.0f, 0.0f, 0.0f});
+    }
+    registry.commands().remove<Velocity>(removed);
+    registry.commands().add<Position>(kept, {4.0f, 5.0f, 6.0f});
+    registry.applyCommands();
+
+    CHECK(Entity(removed).has<Position>());
+    CHECK(!Entity(removed).has<Velocity>());
+    CHECK(!system->entities.contains(removed));
+    CHECK(system->entities.contains(kept));
+    CHECK(registry.peek<Position>(kept).x == 4.0f);
+
+    // Destroying goes through the delayed deletion of refresh
+    registry.commands().destroy(kept);
+    registry.refresh();
+    CHECK(!system->entities.contains(kept));
+    registry.destroyEntity(Entity(removed));
+    registry.refresh();
+}
+}  // namespace
+
+int main() {
+    registerTestComponents();
+    SystemManager::instance().registerSystemType<MovingSystem>();
+
+    addsWhenApplied();
+    appliesInOrder();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,411 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+// ///////////////////////////////////////////////////////////////// Overview //
+// Scalar stand-in for the part of DirectXMath used by the engine's sources
+// built by the tests, on the platforms where the Windows SDK isn't there.
+// The functions follow the documented behaviour of the originals, row
+// vectors and row-major matrices included, but nothing else of them
+#define XM_CALLCONV
+
+namespace DirectX {
+// //////////////////////////////////////////////////////////////// Storage //
+struct XMFLOAT3 {
+    float x, y, z;
+
+    XMFLOAT3() = default;
+    constexpr XMFLOAT3(float const x, float const y, float const z)
+        : x(x), y(y), z(z) {}
+};
+
+struct XMFLOAT4 {
+    float x, y, z, w;
+
+    XMFLOAT4() = default;
+    constexpr XMFLOAT4(float const x, float const y, float const z,
+                       float const w)
+        : x(x), y(y), z(z), w(w) {}
+};
+
+struct XMFLOAT4X4 {
+    float m[4][4];
+};
+
+// /////////////////////////////////////////////////////////////// Vectors //
+struct XMVECTOR {
+    float f[4];
+};
+
+using FXMVECTOR = XMVECTOR const;
+using GXMVECTOR = XMVECTOR const;
+using HXMVECTOR = XMVECTOR const;
+using CXMVECTOR = XMVECTOR const&;
+
+inline XMVECTOR XM_CALLCONV XMVectorSet(float const x, float const y,
+                                        float const z, float const w) {
+    return {{x, y, z, w}};
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorZero() {
+    return {{0.0f, 0.0f, 0.0f, 0.0f}};
+}
+
+inline float XM_CALLCONV XMVectorGetX(FXMVECTOR v) { return v.f[0]; }
+inline float XM_CALLCONV XMVectorGetY(FXMVECTOR v) { return v.f[1]; }
+inline float XM_CALLCONV XMVectorGetZ(FXMVECTOR v) { return v.f[2]; }
+inline float XM_CALLCONV XMVectorGetW(FXMVECTOR v) { return v.f[3]; }
+
+inline XMVECTOR XM_CALLCONV XMLoadFloat3(XMFLOAT3 const* const source) {
+    return {{source->x, source->y, source->z, 0.0f}};
+}
+
+inline XMVECTOR XM_CALLCONV XMLoadFloat4(XMFLOAT4 const* const source) {
+    return {{source->x, source->y, source->z, source->w}};
+}
+
+inline void XM_CALLCONV XMStoreFloat3(XMFLOAT3* const destination,
+                                      FXMVECTOR v) {
+    *destination = {v.f[0], v.f[1], v.f[2]};
+}
+
+inline void XM_CALLCONV XMStoreFloat4(XMFLOAT4* const destination,
+                                      FXMVECTOR v) {
+    *destination = {v.f[0], v.f[1], v.f[2], v.f[3]};
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorSplatOne() {
+    return {{1.0f, 1.0f, 1.0f, 1.0f}};
+}
+
+// Applies the function to every lane of the vectors
+template <typename Function>
+XMVECTOR XM_CALLCONV XMVectorMap(FXMVECTOR a, FXMVECTOR b,
+                                 Function const function) {
+    return {{function(a.f[0], b.f[0]), function(a.f[1], b.f[1]),
+             function(a.f[2], b.f[2]), function(a.f[3], b.f[3])}};
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorAdd(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorMap(a, b, [](float x, float y) { return x + y; });
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorMap(a, b, [](float x, float y) { return x - y; });
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorMap(a, b, [](float x, float y) { return x * y; });
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorScale(FXMVECTOR v, float const scale) {
+    return XMVectorMultiply(v, {{scale, scale, scale, scale}});
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorReciprocalSqrt(FXMVECTOR v) {
+    return XMVectorMap(v, v,
+                       [](float x, float) { return 1.0f / std::sqrt(x); });
+}
+
+inline void XM_CALLCONV XMVectorSinCos(XMVECTOR* const sine,
+                                       XMVECTOR* const cosine, FXMVECTOR v) {
+    *sine = XMVectorMap(v, v, [](float x, float) { return std::sin(x); });
+    *cosine = XMVectorMap(v, v, [](float x, float) { return std::cos(x); });
+}
+
+// Comparisons give lanes with all bits set where they hold, for selecting
+inline XMVECTOR XM_CALLCONV XMVectorGreater(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorMap(a, b, [](float x, float y) {
+        return std::bit_cast<float>(x > y ? ~std::uint32_t{0} : 0u);
+    });
+}
+
+// The lanes of b where the control is set, the ones of a elsewhere
+inline XMVECTOR XM_CALLCONV XMVectorSelect(FXMVECTOR a, FXMVECTOR b,
+                                           FXMVECTOR control) {
+    XMVECTOR result;
+    for (int i = 0; i < 4; ++i) {
+        auto const mask = std::bit_cast<std::uint32_t>(control.f[i]);
+        auto const bitsA = std::bit_cast<std::uint32_t>(a.f[i]);
+        auto const bitsB = std::bit_cast<std::uint32_t>(b.f[i]);
+        result.f[i] = std::bit_cast<float>((bitsA & ~mask) | (bitsB & mask));
+    }
+    return result;
+}
+
+inline XMVECTOR XM_CALLCONV operator+(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorAdd(a, b);
+}
+
+inline XMVECTOR XM_CALLCONV operator-(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorSubtract(a, b);
+}
+
+inline XMVECTOR XM_CALLCONV operator*(FXMVECTOR a, FXMVECTOR b) {
+    return XMVectorMultiply(a, b);
+}
+
+inline XMVECTOR XM_CALLCONV operator*(FXMVECTOR v, float const scale) {
+    return XMVectorScale(v, scale);
+}
+
+inline XMVECTOR XM_CALLCONV operator*(float const scale, FXMVECTOR v) {
+    return XMVectorScale(v, scale);
+}
+
+inline XMVECTOR XM_CALLCONV XMVectorLerp(FXMVECTOR a, FXMVECTOR b,
+                                         float const t) {
+    return {{a.f[0] + t * (b.f[0] - a.f[0]), a.f[1] + t * (b.f[1] - a.f[1]),
+             a.f[2] + t * (b.f[2] - a.f[2]), a.f[3] + t * (b.f[3] - a.f[3])}};
+}
+
+// /////////////////////////////////////////////////////////// Quaternions //
+inline XMVECTOR XM_CALLCONV XMQuaternionNormalize(FXMVECTOR q) {
+    auto const length = std::sqrt(q.f[0] * q.f[0] + q.f[1] * q.f[1] +
+                                  q.f[2] * q.f[2] + q.f[3] * q.f[3]);
+    auto const inverse = length > 0.0f ? 1.0f / length : 0.0f;
+    return {{q.f[0] * inverse, q.f[1] * inverse, q.f[2] * inverse,
+             q.f[3] * inverse}};
+}
+
+// The rotation of a followed by the one of b
+inline XMVECTOR XM_CALLCONV XMQuaternionMultiply(FXMVECTOR a, FXMVECTOR b) {
+    return {{b.f[3] * a.f[0] + b.f[0] * a.f[3] + b.f[1] * a.f[2] -
+                 b.f[2] * a.f[1],
+             b.f[3] * a.f[1] - b.f[0] * a.f[2] + b.f[1] * a.f[3] +
+                 b.f[2] * a.f[0],
+             b.f[3] * a.f[2] + b.f[0] * a.f[1] - b.f[1] * a.f[0] +
+                 b.f[2] * a.f[3],
+             b.f[3] * a.f[3] - b.f[0] * a.f[0] - b.f[1] * a.f[1] -
+                 b.f[2] * a.f[2]}};
+}
+
+// The axis is the vector part of the quaternion, not normalized
+inline void XM_CALLCONV XMQuaternionToAxisAngle(XMVECTOR* const axis,
+                                                float* const angle,
+                                                FXMVECTOR q) {
+    *axis = q;
+    *angle = 2.0f * std::acos(q.f[3]);
+}
+
+// Roll around z first, then pitch around x and yaw around y
+inline XMVECTOR XM_CALLCONV XMQuaternionRotationRollPitchYaw(
+    float const pitch, float const yaw, float const roll) {
+    auto const cp = std::cos(pitch * 0.5f), sp = std::sin(pitch * 0.5f);
+    auto const cy = std::cos(yaw * 0.5f), sy = std::sin(yaw * 0.5f);
+    auto const cr = std::cos(roll * 0.5f), sr = std::sin(roll * 0.5f);
+    return {{cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy,
+             sr * cp * cy - cr * sp * sy, cr * cp * cy + sr * sp * sy}};
+}
+
+// /////////////////////////////////////////////////////////////// Matrices //
+struct XMMATRIX {
+    XMVECTOR r[4];
+
+    XMMATRIX() = default;
+    constexpr XMMATRIX(XMVECTOR const& r0, XMVECTOR const& r1,
+                       XMVECTOR const& r2, XMVECTOR const& r3)
+        : r{r0, r1, r2, r3} {}
+};
+
+using FXMMATRIX = XMMATRIX const;
+using CXMMATRIX = XMMATRIX const&;
+
+inline XMMATRIX XM_CALLCONV XMMatrixIdentity() {
+    return {{{1.0f, 0.0f, 0.0f, 0.0f}},
+            {{0.0f, 1.0f, 0.0f, 0.0f}},
+            {{0.0f, 0.0f, 1.0f, 0.0f}},
+            {{0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+inline XMMATRIX XM_CALLCONV XMMatrixMultiply(FXMMATRIX a, CXMMATRIX b) {
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.r[row].f[column] = a.r[row].f[0] * b.r[0].f[column] +
+                                      a.r[row].f[1] * b.r[1].f[column] +
+                                      a.r[row].f[2] * b.r[2].f[column] +
+                                      a.r[row].f[3] * b.r[3].f[column];
+        }
+    }
+    return result;
+}
+
+inline XMMATRIX XM_CALLCONV operator*(FXMMATRIX a, CXMMATRIX b) {
+    return XMMatrixMultiply(a, b);
+}
+
+inline XMMATRIX& XM_CALLCONV operator*=(XMMATRIX& a, CXMMATRIX b) {
+    a = XMMatrixMultiply(a, b);
+    return a;
+}
+
+inline XMMATRIX XM_CALLCONV XMMatrixTranspose(FXMMATRIX m) {
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.r[row].f[column] = m.r[column].f[row];
+        }
+    }
+    return result;
+}
+
+inline XMMATRIX XM_CALLCONV XMLoadFloat4x4(XMFLOAT4X4 const* const source) {
+    XMMATRIX result;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.r[row].f[column] = source->m[row][column];
+        }
+    }
+    return result;
+}
+
+inline void XM_CALLCONV XMStoreFloat4x4(XMFLOAT4X4* const destination,
+                                        FXMMATRIX m) {
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            destination->m[row][column] = m.r[row].f[column];
+        }
+    }
+}
+
+inline XMMATRIX XM_CALLCONV XMMatrixScaling(float const x, float const y,
+                                            float const z) {
+    return {{{x, 0.0f, 0.0f, 0.0f}},
+            {{0.0f, y, 0.0f, 0.0f}},
+            {{0.0f, 0.0f, z, 0.0f}},
+            {{0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+inline XMMATRIX XM_CALLCONV XMMatrixTranslation(float const x, float const y,
+                                                float const z) {
+    return {{{1.0f, 0.0f, 0.0f, 0.0f}},
+            {{0.0f, 1.0f, 0.0f, 0.0f}},
+            {{0.0f, 0.0f, 1.0f, 0.0f}},
+            {{x, y, z, 1.0f}}};
+}
+
+// Clockwise when looking along the normalized axis
+inline XMMATRIX XM_CALLCONV XMMatrixRotationAxis(FXMVECTOR axis,
+                                                 float const angle) {
+    auto const length = std::sqrt(axis.f[0] * axis.f[0] +
+                                  axis.f[1] * axis.f[1] +
+                                  axis.f[2] * axis.f[2]);
+    auto const x = axis.f[0] / length, y = axis.f[1] / length,
+               z = axis.f[2] / length;
+    auto const s = std::sin(angle), c = std::cos(angle), t = 1.0f - c;
+    return {{{c + t * x * x, t * x * y + s * z, t * x * z - s * y, 0.0f}},
+            {{t * x * y - s * z, c + t * y * y, t * y * z + s * x, 0.0f}},
+            {{t * x * z + s * y, t * y * z - s * x, c + t * z * z, 0.0f}},
+            {{0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+// Roll around z first, then pitch around x and yaw around y
+inline XMMATRIX XM_CALLCONV XMMatrixRotationRollPitchYaw(float const pitch,
+                                                         float const yaw,
+                                                         float const roll) {
+    auto const cp = std::cos(pitch), sp = std::sin(pitch);
+    auto const cy = std::cos(yaw), sy = std::sin(yaw);
+    auto const cr = std::cos(roll), sr = std::sin(roll);
+    return {{{cr * cy + sr * sp * sy, sr * cp, sr * sp * cy - cr * sy, 0.0f}},
+            {{cr * sp * sy - sr * cy, cr * cp, sr * sy + cr * sp * cy, 0.0f}},
+            {{cp * sy, -sp, cp * cy, 0.0f}},
+            {{0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+inline XMMATRIX XM_CALLCONV XMMatrixRotationQuaternion(FXMVECTOR q) {
+    auto const x = q.f[0], y = q.f[1], z = q.f[2], w = q.f[3];
+    return {{{1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w),
+              2.0f * (x * z - y * w), 0.0f}},
+            {{2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z),
+              2.0f * (y * z + x * w), 0.0f}},
+            {{2.0f * (x * z + y * w), 2.0f * (y * z - x * w),
+              1.0f - 2.0f * (x * x + y * y), 0.0f}},
+            {{0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+// Scaling, then the rotation around the origin, then the translation
+inline XMMATRIX XM_CALLCONV XMMatrixAffineTransformation(
+    FXMVECTOR scaling, FXMVECTOR origin, FXMVECTOR rotation,
+    GXMVECTOR translation) {
+    auto const rotationMatrix = XMMatrixRotationQuaternion(rotation);
+    XMMATRIX result;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.r[row].f[column] =
+                rotationMatrix.r[row].f[column] * scaling.f[row];
+        }
+    }
+
+    // The origin is rotated around itself, without the scaling
+    for (int column = 0; column < 3; ++column) {
+        result.r[3].f[column] = -origin.f[0] * rotationMatrix.r[0].f[column] -
+                                origin.f[1] * rotationMatrix.r[1].f[column] -
+                                origin.f[2] * rotationMatrix.r[2].f[column] +
+                                origin.f[column] + translation.f[column];
+    }
+    result.r[3].f[3] = 1.0f;
+    return result;
+}
+
+// ///////////////////////////////////////////////////////////////// Cameras //
+// Left-handed view of the eye looking along the direction
+inline XMMATRIX XM_CALLCONV XMMatrixLookToLH(FXMVECTOR eye,
+                                             FXMVECTOR direction,
+                                             FXMVECTOR up) {
+    auto const normalize = [](float const (&v)[3], float (&result)[3]) {
+        auto const length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        for (int i = 0; i < 3; ++i) {
+            result[i] = v[i] / length;
+        }
+    };
+    auto const cross = [](float const (&a)[3], float const (&b)[3],
+                          float (&result)[3]) {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    };
+
+    float forward[3], right[3], rightUp[3], upward[3];
+    normalize({direction.f[0], direction.f[1], direction.f[2]}, forward);
+    cross({up.f[0], up.f[1], up.f[2]}, forward, rightUp);
+    normalize(rightUp, right);
+    cross(forward, right, upward);
+
+    XMMATRIX result;
+    float const* const axes[] = {right, upward, forward};
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int row = 0; row < 3; ++row) {
+            result.r[row].f[axis] = axes[axis][row];
+        }
+        result.r[3].f[axis] = -(axes[axis][0] * eye.f[0] +
+                                axes[axis][1] * eye.f[1] +
+                                axes[axis][2] * eye.f[2]);
+    }
+    for (int row = 0; row < 3; ++row) {
+        result.r[row].f[3] = 0.0f;
+    }
+    result.r[3].f[3] = 1.0f;
+    return result;
+}
+
+// Left-handed projection with the depth from 0 at the near plane to 1 at
+// the far one
+inline XMMATRIX XM_CALLCONV XMMatrixPerspectiveFovLH(float const fovAngleY,
+                                                     float const aspectRatio,
+                                                     float const nearZ,
+                                                     float const farZ) {
+    auto const height = 1.0f / std::tan(0.5f * fovAngleY);
+    auto const width = height / aspectRatio;
+    auto const range = farZ / (farZ - nearZ);
+    return {{{width, 0.0f, 0.0f, 0.0f}},
+            {{0.0f, height, 0.0f, 0.0f}},
+            {{0.0f, 0.0f, range, 1.0f}},
+            {{0.0f, 0.0f, -range * nearZ, 0.0f}}};
+}
+}  // namespace DirectX
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,51 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <vector>
+
+#include "Check.hpp"
+#include "ECS/EntityManager.hpp"
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+auto& entityManager = EntityManager::instance();
+
+void staleHandles() {
+    auto const entityId = entityManager.create();
+    auto const handle = entityManager.handle(entityId);
+    CHECK(entityManager.valid(handle));
+
+    entityManager.destroy(entityId);
+    CHECK(!entityManager.valid(handle));
+}
+
+// Creates every entity there can be, none of them may be the null one
+void nullHandle() {
+    CHECK(!entityManager.valid(EntityHandle{}));
+
+    std::vector<EntityHandle> handles;
+    for (EntityId i = 1; i < MAX_ENTITIES; ++i) {
+        handles.push_back(entityManager.handle(entityManager.create()));
+    }
+    CHECK(!entityManager.valid(EntityHandle{}));
+
+    auto nullEntities = 0;
+    for (auto const handle : handles) {
+        nullEntities += handle.id() == EntityHandle{}.id() ? 1 : 0;
+    }
+    CHECK(nullEntities == 0);
+
+    // Once all of them are taken, the destroyed identifiers are reused in
+    // order, starting with the one of staleHandles
+    entityManager.destroy(handles.back().id());
+    CHECK(entityManager.create() == 0);
+    CHECK(entityManager.create() == handles.back().id());
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main() {
+    staleHandles();
+    nullHandle();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
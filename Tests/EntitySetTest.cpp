@@ -0,0 +1,170 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "ECS/EntitySet.hpp"
+#include "TestComponents.hpp"
+
+// ///////////////////////////////////////////////////////////////// Helpers //
+namespace {
+std::vector<EntityId> contents(EntitySet const& set) {
+    std::vector<EntityId> entityIds;
+    for (auto const entity : set) {
+        entityIds.push_back(entity.id);
+    }
+    return entityIds;
+}
+
+bool sorted(std::vector<EntityId> const& entityIds) {
+    return std::is_sorted(entityIds.begin(), entityIds.end());
+}
+
+// ///////////////////////////////////////////////////////////////// System //
+ECS_SYSTEM(ActiveSystem) {
+  public:
+    void filters() override { filter<Position>().filter<Active>(); }
+    void setup() override {}
+    void update(float) override {}
+    void release() override {}
+};
+
+// /////////////////////////////////////////////////////////////////// Tests //
+void insertAfterErasingTheLast() {
+    EntitySet set;
+    set.insert(1);
+    set.insert(5);
+    set.insert(9);
+    set.erase(9);
+
+    // The hole at the back mustn't hide the larger entity before it
+    set.insert(3);
+    CHECK((contents(set) == std::vector<EntityId>{1, 3, 5}));
+
+    set.erase(5);
+    set.erase(3);
+    set.insert(2);
+    set.insert(4);
+    CHECK((contents(set) == std::vector<EntityId>{1, 2, 4}));
+}
+
+void insertUnsorted() {
+    EntitySet set;
+    std::vector<EntityId> entityIds(1000);
+    for (size_t i = 0; i < entityIds.size(); ++i) {
+        entityIds[i] = static_cast<EntityId>(i * 3);
+    }
+    std::shuffle(entityIds.begin(), entityIds.end(), std::mt19937{3});
+    for (auto const entityId : entityIds) {
+        set.insert(entityId);
+    }
+    for (size_t i = 0; i < entityIds.size(); i += 2) {
+        set.erase(entityIds[i]);
+    }
+
+    auto const visited = contents(set);
+    CHECK(visited.size() == entityIds.size() / 2);
+    CHECK(sorted(visited));
+}
+
+void nestedLoops() {
+    EntitySet set;
+    for (EntityId entityId = 0; entityId < 100; ++entityId) {
+        set.insert(entityId);
+    }
+    for (EntityId entityId = 0; entityId < 100; entityId += 2) {
+        set.erase(entityId);
+    }
+
+    // Every pair of entities once, while the inner loops erase and insert
+    size_t pairs = 0;
+    size_t outer = 0;
+    for (auto const first : set) {
+        ++outer;
+        for (auto const second : set) {
+            if (first.id < second.id) {
+                ++pairs;
+            }
+        }
+        if (first.id == 51) {
+            set.erase(11);
+            set.insert(200);
+            set.insert(0);
+        }
+    }
+    // The outer loop visits the inserted entities at the end, 0 pairs with
+    // all the others
+    CHECK(outer == 52);
+    CHECK(pairs == 49 * 50 / 2 + 24 + 50);
+
+    auto const visited = contents(set);
+    CHECK(visited.size() == 51);
+    CHECK(sorted(visited));
+    CHECK(visited.front() == 0 && visited.back() == 200);
+}
+
+// Toggles the Active tag of thousands of entities every frame, the way
+// chunks are enabled and disabled, and compares the entities of the system
+// with the expected ones after each frame
+void toggleActive() {
+    auto& registry = Registry::instance();
+    auto const system = registry.system<ActiveSystem>();
+
+    std::vector<EntityId> entityIds;
+    for (int i = 0; i < 8000; ++i) {
+        auto entity = registry.createEntity();
+        entity.add<Position>({});
+        entityIds.push_back(entity.id);
+    }
+
+    std::mt19937 random{11};
+    std::vector<bool> active(entityIds.size());
+    std::vector<EntityId> enabled;
+    std::vector<EntityId> disabled;
+    for (int frame = 0; frame < 50; ++frame) {
+        enabled.clear();
+        disabled.clear();
+        for (size_t i = 0; i < entityIds.size(); ++i) {
+            if (random() % 3 == 0) {
+                active[i] = !active[i];
+                (active[i] ? enabled : disabled).push_back(entityIds[i]);
+            }
+        }
+        registry.tag<Active>(disabled, false);
+        registry.tag<Active>(enabled, true);
+
+        std::vector<EntityId> expected;
+        for (size_t i = 0; i < entityIds.size(); ++i) {
+            if (active[i]) {
+                expected.push_back(entityIds[i]);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        if (contents(system->entities) != expected) {
+            CHECK(contents(system->entities) == expected);
+            break;
+        }
+    }
+
+    for (auto const entityId : entityIds) {
+        registry.destroyEntity(entityId);
+    }
+    registry.refresh();
+    CHECK(system->entities.empty());
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main() {
+    registerTestComponents();
+    SystemManager::instance().registerSystemType<ActiveSystem>();
+
+    insertAfterErasingTheLast();
+    insertUnsorted();
+    nestedLoops();
+    toggleActive();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
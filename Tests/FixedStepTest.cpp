@@ -0,0 +1,208 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Check.hpp"
+#include "Components/Properties.hpp"
+#include "Components/Rigidbody.hpp"
+#include "Components/Transform.hpp"
+#include "ECS/Scheduler.hpp"
+#include "FixedTimestep.hpp"
+#include "Systems/GraphSystem.hpp"
+#include "Systems/PhysicsSystem.hpp"
+#include "TestComponents.hpp"
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+auto& registry = Registry::instance();
+
+constexpr unsigned int STEPS = 150u;
+
+Entity spawn(std::optional<EntityId> const parent, float const height) {
+    auto entity = registry.createEntity();
+    entity.add<Properties>({"Body", "", true});
+    entity.add<Transform>({.parent = parent,
+                           .rotation = {0.0f, 0.0f, 0.0f, 1.0f},
+                           .position = {0.0f, height, 0.0f},
+                           .scale = {1.0f, 1.0f, 1.0f},
+                           .euler = {0.0f, 0.0f, 0.0f},
+                           .root_Order = 0});
+    return entity;
+}
+
+// Bodies falling from different heights at different speeds, each one
+// carrying a child, and a wall which doesn't move. One more body is also
+// walked by a script in every frame, like the player
+struct Scene {
+    std::vector<EntityId> bodies;
+    EntityId wall, walker;
+};
+
+Scene spawnScene() {
+    Scene scene;
+    for (int i = 0; i < 8; ++i) {
+        auto body = spawn(std::nullopt, 0.0f);
+        body.add<Rigidbody>({.mass = 1.0f, .velocity = 0.0f});
+        spawn(body.id, 1.0f);
+        scene.bodies.push_back(body.id);
+    }
+    scene.wall = spawn(std::nullopt, 0.0f).id;
+    auto walker = spawn(std::nullopt, 0.0f);
+    walker.add<Rigidbody>({.mass = 1.0f, .velocity = 0.0f});
+    scene.walker = walker.id;
+
+    registry.refresh();
+    registry.system<GraphSystem>()->setup();
+    return scene;
+}
+
+DirectX::XMVECTOR drawn(EntityId const entityId) {
+    return registry.system<GraphSystem>()->transform(Entity{entityId}).r[3];
+}
+
+float height(EntityId const entityId) {
+    return DirectX::XMVectorGetY(drawn(entityId));
+}
+
+struct Result {
+    std::vector<float> positions, worldHeights;
+    bool smooth{true}, blended{false};
+    bool wallInterpolated{false};
+    bool walkerFollowed{true};
+};
+
+// Runs the same number of steps with frames of the given lengths, the
+// rendered heights are checked in every frame
+Result simulate(Scene& scene, std::function<float(int)> const& frameTime) {
+    auto const graphSystem = registry.system<GraphSystem>();
+    auto const physicsSystem = registry.system<PhysicsSystem>();
+    for (size_t i = 0; i < scene.bodies.size(); ++i) {
+        Entity body{scene.bodies[i]};
+        body.get<Transform>().position.y = 10.0f + static_cast<float>(i);
+        body.get<Rigidbody>().velocity = -0.5f * static_cast<float>(i);
+    }
+    Entity walker{scene.walker};
+    walker.get<Transform>().position = {0.0f, 10.0f, 0.0f};
+    walker.get<Rigidbody>().velocity = 0.0f;
+    physicsSystem->setup();
+    graphSystem->refresh();
+    Scheduler fixedUpdate({physicsSystem, graphSystem});
+
+    Result result;
+    FixedTimestep timestep;
+    auto lastHeight = height(scene.bodies.back());
+    auto lastWalkerHeight = height(scene.walker);
+    for (unsigned int step = 0, frame = 0; step < STEPS; ++frame) {
+        // The script moves with the frames, before the steps
+        walker.get<Transform>().position.x += 2.0f * frameTime(frame);
+
+        auto const steps =
+            std::min(timestep.advance(frameTime(frame)), STEPS - step);
+        for (unsigned int i = 0; i < steps; ++i) {
+            graphSystem->beginStep();
+            fixedUpdate.update(timestep.step());
+        }
+        step += steps;
+        if (steps > 0) {
+            graphSystem->refresh();
+        }
+        graphSystem->interpolate(timestep.fraction());
+        // GraphSystem leads the late update too
+        graphSystem->update(frameTime(frame));
+
+        // The last body is the fastest to fall, it never goes back up
+        // between the frames nor passes the pose of the last step. It's
+        // drawn above that pose until the frames catch up with it
+        auto const rendered = height(scene.bodies.back());
+        auto const stepped =
+            registry.peek<Transform>(scene.bodies.back()).position.y;
+        result.smooth =
+            result.smooth && rendered <= lastHeight && rendered >= stepped;
+        result.blended = result.blended || rendered > stepped;
+        lastHeight = rendered;
+        result.wallInterpolated =
+            result.wallInterpolated ||
+            graphSystem->interpolation(Entity{scene.wall}) < 1.0f;
+
+        // The walker is drawn where the script and the last step left it,
+        // never blended back, so it doesn't go back up either
+        auto const& walkerPosition =
+            registry.peek<Transform>(scene.walker).position;
+        auto const walkerHeight = height(scene.walker);
+        result.walkerFollowed =
+            result.walkerFollowed &&
+            DirectX::XMVectorGetX(drawn(scene.walker)) ==
+                walkerPosition.x &&
+            walkerHeight == walkerPosition.y &&
+            walkerHeight <= lastWalkerHeight;
+        lastWalkerHeight = walkerHeight;
+    }
+
+    graphSystem->interpolate(1.0f);
+    for (auto const body : scene.bodies) {
+        result.positions.push_back(registry.peek<Transform>(body).position.y);
+        result.worldHeights.push_back(height(body));
+    }
+    return result;
+}
+
+// Same results whatever the frame rate, also with uneven frames
+void sameAtAnyFrameRate() {
+    auto scene = spawnScene();
+    auto const reference =
+        simulate(scene, [](int) { return 1.0f / 60.0f; });
+    CHECK(reference.smooth);
+    CHECK(reference.blended);
+    CHECK(!reference.wallInterpolated);
+    CHECK(reference.walkerFollowed);
+    CHECK(reference.positions.front() < 10.0f);
+
+    std::function<float(int)> const frameTimes[] = {
+        [](int) { return 1.0f / 17.0f; },
+        [](int) { return 1.0f / 30.0f; },
+        [](int) { return 1.0f / 144.0f; },
+        [](int) { return 1.0f / 240.0f; },
+        [](int frame) { return frame % 3 == 0 ? 0.045f : 0.004f; },
+    };
+    for (auto const& frameTime : frameTimes) {
+        auto const result = simulate(scene, frameTime);
+        CHECK(result.positions == reference.positions);
+        CHECK(result.worldHeights == reference.worldHeights);
+        CHECK(result.smooth);
+        CHECK(result.blended);
+        CHECK(!result.wallInterpolated);
+        CHECK(result.walkerFollowed);
+    }
+}
+
+// Long frames take at most the allowed number of steps and drop the rest,
+// whole steps only
+void limitedSteps() {
+    FixedTimestep timestep;
+    timestep.rate(50.0f);
+    timestep.maxSteps(3u);
+    CHECK(timestep.advance(0.5f) == 3u);
+    CHECK(timestep.fraction() >= 0.0f && timestep.fraction() < 1.0f);
+    CHECK(timestep.advance(0.01f) <= 1u);
+    CHECK(timestep.advance(-1.0f) == 0u);
+}
+}  // namespace
+
+int main() {
+    registerTestComponents();
+    ECS_REGISTER_COMPONENT(Properties);
+    ECS_REGISTER_COMPONENT(Rigidbody);
+    ECS_REGISTER_COMPONENT(Transform);
+    SystemManager::instance().registerSystemType<GraphSystem>();
+    SystemManager::instance().registerSystemType<PhysicsSystem>();
+
+    sameAtAnyFrameRate();
+    limitedSteps();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
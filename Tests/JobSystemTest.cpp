@@ -0,0 +1,90 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "Check.hpp"
+#include "JobSystem.hpp"
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+auto& jobSystem = JobSystem::instance();
+
+// Every index is visited once, whatever number of threads runs the jobs
+void parallelFor() {
+    for (size_t const threads : {1u, 2u, 0u}) {
+        jobSystem.limit(threads);
+
+        std::vector<std::atomic<int>> visits(10000);
+        jobSystem.parallelFor(
+            visits.size(), [&visits](size_t const i) { ++visits[i]; }, 16);
+
+        auto once = 0;
+        for (auto const& visit : visits) {
+            once += visit == 1 ? 1 : 0;
+        }
+        CHECK(once == static_cast<int>(visits.size()));
+    }
+}
+
+// Jobs waiting for the jobs they started
+void nestedJobs() {
+    std::atomic<int> finished{0};
+    JobGroup outer;
+    for (int i = 0; i < 8; ++i) {
+        jobSystem.run(outer, [&finished] {
+            JobGroup inner;
+            for (int j = 0; j < 8; ++j) {
+                jobSystem.run(inner, [&finished] { ++finished; });
+            }
+            jobSystem.wait(inner);
+        });
+    }
+    jobSystem.wait(outer);
+    CHECK(finished == 64);
+}
+
+// A throwing job still finishes its group, the wait rethrows the exception
+// once the other jobs are done
+void exceptions() {
+    std::atomic<int> finished{0};
+    JobGroup group;
+    for (int i = 0; i < 16; ++i) {
+        jobSystem.run(group, [&finished, i] {
+            if (i % 4 == 0) {
+                throw std::runtime_error("job failed");
+            }
+            ++finished;
+        });
+    }
+
+    auto thrown = false;
+    try {
+        jobSystem.wait(group);
+    } catch (std::runtime_error const&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(group.done());
+    CHECK(finished == 12);
+
+    // The exception is rethrown only once
+    thrown = false;
+    try {
+        jobSystem.wait(group);
+    } catch (...) {
+        thrown = true;
+    }
+    CHECK(!thrown);
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main() {
+    parallelFor();
+    nestedJobs();
+    exceptions();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,136 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Check.hpp"
+#include "ECS/Scheduler.hpp"
+#include "TestComponents.hpp"
+
+// ////////////////////////////////////////////////////////////////// Systems //
+namespace {
+auto& registry = Registry::instance();
+std::atomic<int> restrictedReads{0};
+
+// Reads the positions while the other reader does the same
+template <typename WrittenType>
+struct ReadingSystem : public System,
+                       public SystemWrapper<ReadingSystem<WrittenType>>,
+                       public SystemRegistrant<ReadingSystem<WrittenType>> {
+    void filters() override {
+        this->template filter<Position>().template filter<WrittenType>();
+        this->template read<Position>().template write<WrittenType>();
+    }
+    void setup() override {}
+    void update(float) override {
+        if (!Registry::writable(registry.componentId<Position>()) &&
+            Registry::writable(registry.componentId<WrittenType>())) {
+            ++restrictedReads;
+        }
+        for (auto const entity : entities) {
+            sum += std::as_const(entity).template get<Position>().x;
+        }
+    }
+    void release() override {}
+
+    float sum{0.0f};
+};
+
+ECS_SYSTEM(WritingSystem) {
+  public:
+    void filters() override {
+        filter<Position>();
+        write<Position>();
+    }
+    void setup() override {}
+    void update(float) override {
+        for (auto entity : entities) {
+            entity.get<Position>().x += 1.0f;
+        }
+    }
+    void release() override {}
+};
+
+ECS_SYSTEM(ThrowingSystem) {
+  public:
+    void filters() override { write<Bounds>(); }
+    void setup() override {}
+    void update(float) override { throw std::runtime_error("system failed"); }
+    void release() override {}
+};
+
+size_t changed(ChangeVersion& since) {
+    size_t count = 0;
+    since = registry.eachChanged<Position>(
+        since, [&count](EntityId) { ++count; });
+    return count;
+}
+
+// /////////////////////////////////////////////////////////////////// Tests //
+// Readers scheduled together don't mark the components they read as changed,
+// only the writer does
+void readsDontChange() {
+    for (int i = 0; i < 1000; ++i) {
+        auto entity = registry.createEntity();
+        entity.add<Position>({1.0f, 0.0f, 0.0f});
+        entity.add<Velocity>({});
+        entity.add<Bounds>({});
+    }
+
+    auto const readingVelocity = registry.system<ReadingSystem<Velocity>>();
+    auto const readingBounds = registry.system<ReadingSystem<Bounds>>();
+    Scheduler readers{{readingVelocity, readingBounds}};
+
+    ChangeVersion since = 0;
+    changed(since);
+    readers.update(0.016f);
+    CHECK(restrictedReads == 2);
+    CHECK(readingVelocity->sum == 1000.0f && readingBounds->sum == 1000.0f);
+    CHECK(changed(since) == 0);
+
+    // Outside of the scheduled systems nothing is restricted
+    CHECK(Registry::writable(registry.componentId<Position>()));
+
+    Scheduler writers{{registry.system<WritingSystem>()}};
+    writers.update(0.016f);
+    CHECK(changed(since) == 1000);
+}
+
+// The failed system doesn't stop the others, the exception reaches the
+// caller after the frame and the next one runs as usual
+void exceptions() {
+    auto const reading = registry.system<ReadingSystem<Velocity>>();
+    Scheduler scheduler{{registry.system<ThrowingSystem>(), reading}};
+
+    for (int frame = 0; frame < 2; ++frame) {
+        auto const sum = reading->sum;
+        auto thrown = false;
+        try {
+            scheduler.update(0.016f);
+        } catch (std::runtime_error const&) {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(reading->sum > sum);
+    }
+    CHECK(Registry::writable(registry.componentId<Bounds>()));
+}
+}  // namespace
+
+// ///////////////////////////////////////////////////////////////////// Main //
+int main() {
+    registerTestComponents();
+    auto& systemManager = SystemManager::instance();
+    systemManager.registerSystemType<ReadingSystem<Velocity>>();
+    systemManager.registerSystemType<ReadingSystem<Bounds>>();
+    systemManager.registerSystemType<WritingSystem>();
+    systemManager.registerSystemType<ThrowingSystem>();
+
+    readsDontChange();
+    exceptions();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,151 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Check.hpp"
+#include "JobSystem.hpp"
+#include "SeparationSums.hpp"
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+using Sum = SeparationSums::Sum;
+
+struct Pair {
+    EntityId first, second;
+    DirectX::XMFLOAT3 vector;
+    bool separateFirst, separateSecond;
+};
+
+// Pairs of a few entities colliding many times, spread over several chunks,
+// some of them pushing along one axis only
+std::vector<Pair> randomPairs(size_t const count) {
+    std::mt19937 random(3u);
+    std::uniform_int_distribution<EntityId> entity(0u, 40u);
+    std::uniform_real_distribution<float> length(-1.0f, 1.0f);
+
+    std::vector<Pair> pairs;
+    for (size_t i = 0; i < count; ++i) {
+        auto const first = entity(random);
+        auto const second = first + 1u + entity(random);
+        DirectX::XMFLOAT3 vector{length(random), length(random),
+                                 length(random)};
+        if (i % 3 == 0) {
+            vector.x = vector.z = 0.0f;
+        }
+        pairs.push_back({first, second, vector, i % 4 != 0, i % 5 == 0});
+    }
+    return pairs;
+}
+
+std::vector<Sum> accumulate(std::vector<Pair> const& pairs) {
+    SeparationSums separationSums;
+    separationSums.accumulate(
+        pairs.size(), [&pairs](size_t const i, std::vector<Sum>& separations) {
+            auto const& pair = pairs[i];
+            if (pair.separateFirst) {
+                separations.push_back(
+                    SeparationSums::separation(pair.first, pair.vector));
+            }
+            if (pair.separateSecond) {
+                separations.push_back(
+                    SeparationSums::separation(pair.second, pair.vector));
+            }
+        });
+    return separationSums.sums();
+}
+
+bool near(float const a, float const b) { return std::abs(a - b) < 1e-4f; }
+
+bool same(std::vector<Sum> const& a, std::vector<Sum> const& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].entityId != b[i].entityId || a[i].vector.x != b[i].vector.x ||
+            a[i].vector.y != b[i].vector.y || a[i].vector.z != b[i].vector.z ||
+            a[i].count.x != b[i].count.x || a[i].count.y != b[i].count.y ||
+            a[i].count.z != b[i].count.z) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every entity gets the vectors and the counts of its own side of the pairs
+void sumsPerEntity() {
+    auto const pairs = randomPairs(3 * SeparationSums::CHUNK_SIZE + 17);
+    auto const sums = accumulate(pairs);
+
+    std::vector<Sum> expected(100);
+    for (EntityId i = 0; i < expected.size(); ++i) {
+        expected[i] = {i, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    }
+    for (auto const& pair : pairs) {
+        for (auto const& [entityId, separate] :
+             {std::pair{pair.first, pair.separateFirst},
+              std::pair{pair.second, pair.separateSecond}}) {
+            if (!separate) {
+                continue;
+            }
+            auto& sum = expected[entityId];
+            sum.vector.x += pair.vector.x;
+            sum.vector.y += pair.vector.y;
+            sum.vector.z += pair.vector.z;
+            sum.count.x += pair.vector.x != 0.0f ? 1.0f : 0.0f;
+            sum.count.y += pair.vector.y != 0.0f ? 1.0f : 0.0f;
+            sum.count.z += pair.vector.z != 0.0f ? 1.0f : 0.0f;
+        }
+    }
+
+    auto mismatches = 0;
+    size_t entities = 0;
+    for (auto const& sum : expected) {
+        if (sum.count.x + sum.count.y + sum.count.z == 0.0f) {
+            continue;
+        }
+        if (entities == sums.size()) {
+            ++mismatches;
+            break;
+        }
+        auto const& found = sums[entities++];
+        mismatches += found.entityId != sum.entityId ? 1 : 0;
+        mismatches += !near(found.vector.x, sum.vector.x) ||
+                              !near(found.vector.y, sum.vector.y) ||
+                              !near(found.vector.z, sum.vector.z)
+                          ? 1
+                          : 0;
+        mismatches += found.count.x != sum.count.x ||
+                              found.count.y != sum.count.y ||
+                              found.count.z != sum.count.z
+                          ? 1
+                          : 0;
+    }
+    CHECK(mismatches == 0);
+    CHECK(entities == sums.size());
+    CHECK(accumulate({}).empty());
+}
+
+// The same sums, to the last bit, whatever number of threads adds them up
+void sameWithAnyThreads() {
+    auto const pairs = randomPairs(20 * SeparationSums::CHUNK_SIZE);
+    auto& jobSystem = JobSystem::instance();
+    jobSystem.limit(1u);
+    auto const reference = accumulate(pairs);
+    for (size_t const threads : {2u, 4u, 0u}) {
+        jobSystem.limit(threads);
+        CHECK(same(accumulate(pairs), reference));
+    }
+}
+}  // namespace
+
+int main() {
+    sumsPerEntity();
+    sameWithAnyThreads();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
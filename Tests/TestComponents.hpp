@@ -0,0 +1,28 @@
+#pragma once
+
+// ///////////////////////////////////////////////////////////////// Includes //
+#include "Components/Tags.hpp"
+#include "ECS/ECS.hpp"
+
+// /////////////////////////////////////////////////////////////// Components //
+// Stand-ins for the engine's components, which mostly need DirectX, with
+// similar sizes. The identifiers follow the ones used by the engine
+ECS_COMPONENT(Position) { float x, y, z; };
+ECS_COMPONENT(Velocity) { float x, y, z; };
+ECS_COMPONENT(Bounds) { float min[3], max[3]; };
+
+ECS_SET_COMPONENT_ID(Position, 19u)
+ECS_SET_COMPONENT_ID(Velocity, 20u)
+ECS_SET_COMPONENT_ID(Bounds, 21u)
+
+// Registers the components above and the tags, once per program
+inline void registerTestComponents() {
+    ECS_REGISTER_COMPONENT(Position);
+    ECS_REGISTER_COMPONENT(Velocity);
+    ECS_REGISTER_COMPONENT(Bounds);
+    ECS_REGISTER_COMPONENT(Active);
+    ECS_REGISTER_COMPONENT(Refractive);
+    ECS_REGISTER_COMPONENT(CheckCollisions);
+}
+
+// ////////////////////////////////////////////////////////////////////////// //
@@ -0,0 +1,143 @@
+// ///////////////////////////////////////////////////////////////// Includes //
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "Components/Transform.hpp"
+#include "TransformBatch.hpp"
+
+// /////////////////////////////////////////////////////////////// Namespaces //
+namespace dx = DirectX;
+
+// /////////////////////////////////////////////////////////////////// Tests //
+namespace {
+// How the graph composed the local matrices before the batches, one matrix
+// per part of the transform
+dx::XMMATRIX composeMatrices(Transform const& transform) {
+    dx::XMVECTOR quaternion =
+        dx::XMVectorSet(transform.rotation.x, transform.rotation.y,
+                        transform.rotation.z, transform.rotation.w);
+
+    dx::XMVECTOR axis;
+    float angle;
+    dx::XMQuaternionToAxisAngle(&axis, &angle, quaternion);
+
+    dx::XMMATRIX result = dx::XMMatrixIdentity();
+    result *= dx::XMMatrixScaling(transform.scale.x, transform.scale.y,
+                                  transform.scale.z);
+    if (angle) {
+        result *= dx::XMMatrixRotationAxis(axis, angle);
+    }
+    result *= dx::XMMatrixRotationRollPitchYaw(
+        transform.euler.x, transform.euler.y, transform.euler.z);
+    result *= dx::XMMatrixTranslation(
+        transform.position.x, transform.position.y, transform.position.z);
+    return result;
+}
+
+bool near(dx::XMFLOAT4X4 const& a, dx::XMFLOAT4X4 const& b) {
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            auto const tolerance =
+                1e-5f * std::max(1.0f, std::abs(b.m[row][column]));
+            if (!(std::abs(a.m[row][column] - b.m[row][column]) <=
+                  tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Normalized rotations, as the old composition expects them, with every
+// fifth one left at identity so its axis rotation is skipped
+std::vector<Transform> randomTransforms(size_t const count) {
+    std::mt19937 random(7u);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+    std::vector<Transform> transforms(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto& transform = transforms[i];
+        dx::XMFLOAT4 rotation{unit(random), unit(random), unit(random),
+                              unit(random)};
+        auto const length =
+            std::sqrt(rotation.x * rotation.x + rotation.y * rotation.y +
+                      rotation.z * rotation.z + rotation.w * rotation.w);
+        transform.rotation =
+            i % 5 == 0 ? dx::XMFLOAT4{0.0f, 0.0f, 0.0f, 1.0f}
+                       : dx::XMFLOAT4{rotation.x / length, rotation.y / length,
+                                      rotation.z / length,
+                                      rotation.w / length};
+        transform.euler = {angle(random), angle(random), angle(random)};
+        transform.scale = {scale(random), scale(random), scale(random)};
+        transform.position = {position(random), position(random),
+                              position(random)};
+    }
+    return transforms;
+}
+
+// Both ways of composing give the old matrices, also for a count which
+// doesn't fill the last block
+void matchesMatrices(size_t const count) {
+    auto const transforms = randomTransforms(count);
+
+    TransformBatch batch;
+    for (auto const& transform : transforms) {
+        batch.add(transform);
+    }
+    CHECK(batch.size() == count);
+
+    std::vector<dx::XMMATRIX> matrices(count);
+    batch.compose(matrices);
+    std::vector<dx::XMFLOAT4X4> scalarMatrices(count);
+    batch.composeScalar(scalarMatrices);
+
+    auto mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        dx::XMFLOAT4X4 expected, composed;
+        dx::XMStoreFloat4x4(&expected, composeMatrices(transforms[i]));
+        dx::XMStoreFloat4x4(&composed, matrices[i]);
+        mismatches += near(composed, expected) ? 0 : 1;
+        mismatches += near(scalarMatrices[i], expected) ? 0 : 1;
+    }
+    CHECK(mismatches == 0);
+}
+
+// A cleared batch starts over
+void reuse() {
+    auto const transforms = randomTransforms(6);
+
+    TransformBatch batch;
+    for (auto const& transform : transforms) {
+        batch.add(transform);
+    }
+    batch.clear();
+    CHECK(batch.size() == 0);
+
+    batch.add(transforms[3]);
+    std::vector<dx::XMMATRIX> matrices(1);
+    batch.compose(matrices);
+
+    dx::XMFLOAT4X4 expected, composed;
+    dx::XMStoreFloat4x4(&expected, composeMatrices(transforms[3]));
+    dx::XMStoreFloat4x4(&composed, matrices[0]);
+    CHECK(near(composed, expected));
+}
+}  // namespace
+
+int main() {
+    matchesMatrices(1);
+    matchesMatrices(4);
+    matchesMatrices(1001);
+    reuse();
+    return failures();
+}
+
+// ////////////////////////////////////////////////////////////////////////// //